@@ -0,0 +1,2445 @@
+/*
+ * @Description    : Parameters benchmark
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 09:12:40
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 09:12:40
+ * @FilePath       : \Parameters\bench\parameters_bench.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "Parameters.h"
+#include "Parameters_mavlink.h"
+#include "Parameters_table.h"
+#include "Parameters_registry.h"
+#include "Parameters_lean.h"
+#include "Parameters_checksum.h"
+#include "Parameters_posix.h"
+#include "Parameters_file.h"
+#include "sim_flash.h"
+
+#define BENCH_LOOKUPS 200000
+#define BENCH_PREFIXES 2000
+#define BENCH_PREFIX "PARAM_0001" // PARAM_00010 to PARAM_00019 at every size
+#define BENCH_WRITES 5000
+#define BENCH_WEAR_WRITES 20000
+#define BENCH_WEAR_SECTOR 1024
+#define BENCH_WEAR_SECTORS 16
+#define BENCH_CALL_LATENCY_NS 20000
+#define BENCH_BYTE_COST_NS 100
+#define BENCH_LAZY_PAGE 32
+#define BENCH_STRESS_PARAMS 64
+#define BENCH_STRESS_READERS 3
+#define BENCH_STRESS_MS 300
+#define BENCH_POLL_CHANGE 1000
+#define BENCH_MIRROR_ROUNDS 200
+#define BENCH_MIRROR_CHANGES 16
+#define BENCH_MIRROR_BUFFER 32
+#define BENCH_MIRROR_LOG 256
+#define BENCH_MAVLINK_MESSAGES 1000000
+#define BENCH_MAVLINK_BUDGET 1024
+#define BENCH_ASYNC_PARAMS 64
+#define BENCH_ASYNC_HOT 8
+#define BENCH_ASYNC_CHANGES 1000
+#define BENCH_ASYNC_WRITE_US 100
+#define BENCH_ASYNC_FAILURES 20
+#define BENCH_SECTOR 4096
+#define BENCH_ERASE_COST_NS 4000000
+#define BENCH_SUITE_LOOKUPS 20000
+#define BENCH_SUITE_INITS 20
+#define BENCH_SUITE_DELETES 64
+#define BENCH_FAIL_EVERY 50
+#define BENCH_DECLARED_BOOTS 200
+#define BENCH_REGISTRY_PARAMS 64
+#define BENCH_REGISTRY_GROWTH 2
+#define BENCH_REGISTRY_SECTOR 256
+#define BENCH_CHECKOUT_BYTES (64ul << 20)
+#define BENCH_FILE_PATH "/tmp/parameters_bench.rom"
+#define BENCH_FILE_PARAMS 64
+#define BENCH_FILE_CHANGES 2000
+#define BENCH_FILE_WINDOW_US 2000
+#define BENCH_CRASH_PARAMS 64
+#define BENCH_CRASH_SIZE ((BENCH_CRASH_PARAMS + 1) * 21 + 1)
+#define BENCH_CRASH_JOURNAL_SIZE 8192
+#define BENCH_CRASH_ROM 16384 // room for two banks or the journal
+#define BENCH_CRASH_RUNS 20
+#define BENCH_CRASH_MIN_US 1000
+#define BENCH_CRASH_MAX_US 20000
+
+// parameters declared at build time, as the modules of a firmware would
+#define BENCH_PARAMETERS(X, P) \
+    X(P, ATT_PARAM_00, F32, 0.5f) \
+    X(P, ATT_PARAM_01, UINT16, 100) \
+    X(P, ATT_PARAM_02, INT32, -7) \
+    X(P, ATT_PARAM_03, UINT8, 1) \
+    X(P, ATT_PARAM_04, F32, 0.5f) \
+    X(P, ATT_PARAM_05, UINT16, 100) \
+    X(P, ATT_PARAM_06, INT32, -7) \
+    X(P, ATT_PARAM_07, UINT8, 1) \
+    X(P, POS_PARAM_00, F32, 0.5f) \
+    X(P, POS_PARAM_01, UINT16, 100) \
+    X(P, POS_PARAM_02, INT32, -7) \
+    X(P, POS_PARAM_03, UINT8, 1) \
+    X(P, POS_PARAM_04, F32, 0.5f) \
+    X(P, POS_PARAM_05, UINT16, 100) \
+    X(P, POS_PARAM_06, INT32, -7) \
+    X(P, POS_PARAM_07, UINT8, 1) \
+    X(P, NAV_PARAM_00, F32, 0.5f) \
+    X(P, NAV_PARAM_01, UINT16, 100) \
+    X(P, NAV_PARAM_02, INT32, -7) \
+    X(P, NAV_PARAM_03, UINT8, 1) \
+    X(P, NAV_PARAM_04, F32, 0.5f) \
+    X(P, NAV_PARAM_05, UINT16, 100) \
+    X(P, NAV_PARAM_06, INT32, -7) \
+    X(P, NAV_PARAM_07, UINT8, 1) \
+    X(P, BAT_PARAM_00, F32, 0.5f) \
+    X(P, BAT_PARAM_01, UINT16, 100) \
+    X(P, BAT_PARAM_02, INT32, -7) \
+    X(P, BAT_PARAM_03, UINT8, 1) \
+    X(P, BAT_PARAM_04, F32, 0.5f) \
+    X(P, BAT_PARAM_05, UINT16, 100) \
+    X(P, BAT_PARAM_06, INT32, -7) \
+    X(P, BAT_PARAM_07, UINT8, 1)
+
+PARAMETERS_TABLE_DECLARE(BENCH, BENCH_PARAMETERS)
+PARAMETERS_TABLE_DEFINE(BENCH, BENCH_PARAMETERS)
+
+static unsigned char *simulation_ROM;
+static unsigned int simulation_ROM_size;
+static unsigned int simulation_ROM_writes;
+static unsigned long simulation_ROM_bytes;
+static unsigned int simulation_ROM_delay_us; // time taken by every write
+static unsigned int simulation_ROM_failures; // next writes to fail
+static unsigned int simulation_ROM_cut;      // writes left plus one before the power is cut, 0 keeps it on
+
+static PARAMETERS_CHECK_T checksum(unsigned char *data, unsigned int size)
+{
+    PARAMETERS_CHECK_T sum = 0;
+    while (size)
+    {
+        sum += *data;
+        data++;
+        size--;
+    }
+    return sum;
+}
+
+static bool Read_From_ROM(unsigned char *dst, unsigned int offset, unsigned int size)
+{
+    if (offset + size > simulation_ROM_size)
+    {
+        return false;
+    }
+    memcpy(dst, simulation_ROM + offset, size);
+    return true;
+}
+
+static bool Write_2_ROM(unsigned char *src, unsigned int offset, unsigned int size)
+{
+    struct timespec delay = {0, simulation_ROM_delay_us * 1000L};
+
+    if (simulation_ROM_delay_us != 0)
+    {
+        nanosleep(&delay, NULL);
+    }
+    if (offset + size > simulation_ROM_size || simulation_ROM_failures != 0 || simulation_ROM_cut == 1)
+    {
+        simulation_ROM_failures -= simulation_ROM_failures != 0;
+        return false;
+    }
+    simulation_ROM_cut -= simulation_ROM_cut != 0;
+    memcpy(simulation_ROM + offset, src, size);
+    simulation_ROM_writes++;
+    simulation_ROM_bytes += size;
+    return true;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_name(char *name, unsigned int index)
+{
+    snprintf(name, 17, "PARAM_%05u", index);
+}
+
+typedef struct
+{
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    unsigned int size;
+    unsigned char *RAM;
+    unsigned int number;
+    char (*names)[17];
+} BENCH_TABLE_T;
+
+/**
+ * @description:                                Create a table of float parameters on a fresh simulated ROM
+ * @param       {BENCH_TABLE_T} *bench          table to set up
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {PARAMETERS_CONFIG_T} *config   options, the hash block is allocated here when hash_size is not 0
+ * @return      {*}
+ * @note       :
+ */
+static void bench_open(BENCH_TABLE_T *bench, unsigned int number, const PARAMETERS_CONFIG_T *config)
+{
+    unsigned int count;
+    float value = 0.0f;
+
+    memset(bench, 0, sizeof(BENCH_TABLE_T));
+    bench->number = number;
+    bench->size = (number + 1) * 21 + 1;
+    bench->RAM = malloc(bench->size);
+    bench->names = malloc(number * 17);
+    bench->config = *config;
+    if (bench->config.dirty_block != NULL)
+    {
+        bench->config.dirty_block = malloc(Parameters_Dirty_Size(bench->size));
+    }
+    if (bench->config.name_block != NULL)
+    {
+        bench->config.name_block = aligned_alloc(16, Parameters_Offset_Count(bench->size) * 16);
+    }
+    if (bench->config.sort_map != NULL)
+    {
+        bench->config.sort_map = malloc(Parameters_Offset_Count(bench->size) * sizeof(unsigned short));
+    }
+    if (bench->config.hash_size != 0)
+    {
+        bench->config.hash_size = Parameters_Hash_Slots(bench->size);
+        bench->config.hash_block = malloc(bench->config.hash_size * sizeof(unsigned short));
+    }
+
+    simulation_ROM_size = Parameters_ROM_Size(bench->size, &bench->config) + 64;
+    simulation_ROM = calloc(1, simulation_ROM_size);
+
+    Parameters_Init_Ex(&bench->table, "BENCH", bench->RAM, 0, bench->size, Read_From_ROM, Write_2_ROM, checksum, &bench->config);
+    for (count = 0; count < number; count++)
+    {
+        bench_name(bench->names[count], count);
+        Parameters_Creat(&bench->table, bench->names[count], PARAMETERS_TYPE_F32, &value);
+    }
+}
+
+static void bench_close(BENCH_TABLE_T *bench)
+{
+    free(bench->config.name_block);
+    free(bench->config.sort_map);
+    free(bench->config.hash_block);
+    free(bench->config.dirty_block);
+    free(bench->names);
+    free(bench->RAM);
+    free(simulation_ROM);
+}
+
+/**
+ * @description:                                Time Parameters_Get_by_name over every parameter of a table
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} hashed                   search through the hash index or linearly
+ * @return      {*}                             average nanoseconds per lookup
+ * @note       :
+ */
+static double bench_lookup(unsigned int number, bool hashed)
+{
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    unsigned int count;
+    unsigned short index;
+    float value;
+    double start, cost;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = hashed;
+    bench_open(&bench, number, &config);
+
+    start = now_ns();
+    for (count = 0; count < BENCH_LOOKUPS; count++)
+    {
+        if (Parameters_Get_by_name(&bench.table, bench.names[(count * 7919u) % number], &index, &value) != PARAMETERS_TYPE_F32)
+        {
+            printf("lookup %s failed\n", bench.names[(count * 7919u) % number]);
+        }
+    }
+    cost = (now_ns() - start) / BENCH_LOOKUPS;
+
+    bench_close(&bench);
+    return cost;
+}
+
+/**
+ * @description:                                Scan throughput of the linear search
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} named                    compare the slots of a name block or the identifiers in the cells
+ * @return      {*}                             millions of identifiers compared per second
+ * @note       :
+ */
+static double bench_scan(unsigned int number, bool named)
+{
+    static unsigned char enable[16];
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    unsigned long compared = 0;
+    unsigned int count;
+    unsigned short index;
+    float value;
+    double start;
+
+    memset(&config, 0, sizeof(config));
+    if (named)
+    {
+        config.name_block = &enable;
+    }
+    bench_open(&bench, number, &config);
+
+    start = now_ns();
+    for (count = 0; count < BENCH_LOOKUPS; count++)
+    {
+        if (Parameters_Get_by_name(&bench.table, bench.names[(count * 7919u) % number], &index, &value) != PARAMETERS_TYPE_F32)
+        {
+            printf("lookup %s failed\n", bench.names[(count * 7919u) % number]);
+        }
+        compared += index + 1;
+    }
+    start = now_ns() - start;
+
+    bench_close(&bench);
+    return compared / start * 1000.0;
+}
+
+/**
+ * @description:                                Time a query of the parameters under a prefix and a lookup by name
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} sorted                   Parameters_Find_Prefix on the sorted index, or Parameters_Get_by_index
+ *                                              over the table comparing every identifier
+ * @param       {double} *lookup_ns             average nanoseconds of Parameters_Get_by_name without a hash index
+ * @return      {*}                             average nanoseconds per query of the BENCH_PREFIX parameters
+ * @note       :
+ */
+static double bench_prefix(unsigned int number, bool sorted, double *lookup_ns)
+{
+    static unsigned short enable;
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    unsigned int count, found = 0;
+    unsigned short index, cursor;
+    char name[17] = {0};
+    float value;
+    double start, cost;
+
+    memset(&config, 0, sizeof(config));
+    if (sorted)
+    {
+        config.sort_map = &enable;
+    }
+    bench_open(&bench, number, &config);
+
+    start = now_ns();
+    for (count = 0; count < BENCH_PREFIXES; count++)
+    {
+        if (sorted)
+        {
+            cursor = 0;
+            while (Parameters_Find_Prefix(&bench.table, BENCH_PREFIX, &cursor, name, &value) != 0)
+            {
+                found++;
+            }
+            continue;
+        }
+        for (index = 0; Parameters_Get_by_index(&bench.table, index, name, &value) != 0; index++)
+        {
+            if (strncmp(name, BENCH_PREFIX, strlen(BENCH_PREFIX)) == 0)
+            {
+                found++;
+            }
+        }
+    }
+    cost = (now_ns() - start) / BENCH_PREFIXES;
+    if (found != BENCH_PREFIXES * 10)
+    {
+        printf("prefix %s found %u\n", BENCH_PREFIX, found / BENCH_PREFIXES);
+    }
+
+    start = now_ns();
+    for (count = 0; count < BENCH_LOOKUPS; count++)
+    {
+        if (Parameters_Get_by_name(&bench.table, bench.names[(count * 7919u) % number], &index, &value) != PARAMETERS_TYPE_F32)
+        {
+            printf("lookup %s failed\n", bench.names[(count * 7919u) % number]);
+        }
+    }
+    *lookup_ns = (now_ns() - start) / BENCH_LOOKUPS;
+
+    bench_close(&bench);
+    return cost;
+}
+
+/**
+ * @description:                                Time Parameters_Lean_Get_by_name over every parameter of a lean table
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {unsigned int} *bytes           bytes of RAM taken by the table
+ * @return      {*}                             average nanoseconds per lookup
+ * @note       :                                The cells are written by a hashed table in the incremental check mode,
+ *                                              the lean table then opens its ROM image
+ */
+static double bench_lean(unsigned int number, unsigned int *bytes)
+{
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_LEAN_T lean;
+    unsigned int *RAM;
+    unsigned int count;
+    unsigned short index;
+    float value;
+    double start, cost;
+
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.hash_size = true;
+    bench_open(&bench, number, &config);
+    *bytes = Parameters_Lean_Size(bench.size);
+    RAM = malloc(*bytes);
+
+    Parameters_Lean_Init(&lean, "BENCH", (unsigned char *)RAM, 0, bench.size, Read_From_ROM, Write_2_ROM, checksum);
+    start = now_ns();
+    for (count = 0; count < BENCH_LOOKUPS; count++)
+    {
+        if (Parameters_Lean_Get_by_name(&lean, bench.names[(count * 7919u) % number], &index, &value) != PARAMETERS_TYPE_F32)
+        {
+            printf("lookup %s failed\n", bench.names[(count * 7919u) % number]);
+        }
+    }
+    cost = (now_ns() - start) / BENCH_LOOKUPS;
+
+    free(RAM);
+    bench_close(&bench);
+    return cost;
+}
+
+/**
+ * @description:                                Poll one parameter of a table for changes
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {unsigned char} method          <0> Parameters_Get_by_name and compare the value
+ *                                              <1> compare Parameters_Version <2> compare Parameters_Subscription_Generation
+ * @return      {*}                             average nanoseconds per poll
+ * @note       :                                The parameter changes every BENCH_POLL_CHANGE polls, every change must be seen
+ */
+static double bench_poll(unsigned int number, unsigned char method)
+{
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_SUBSCRIPTION_T subscription;
+    PARAMETERS_HANDLE_T handle;
+    unsigned int count, seen = 0, changes = 0, now = 0;
+    unsigned short index;
+    unsigned char id;
+    float value, last = 0.0f;
+    double start, cost;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = 1;
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.version_map = malloc(Parameters_Offset_Count((number + 1) * 21 + 1) * sizeof(unsigned int));
+    config.subscription_block = &subscription;
+    config.subscription_size = 1;
+    bench_open(&bench, number, &config);
+    Parameters_Get_Handle(&bench.table, bench.names[number / 2], &handle);
+    Parameters_Subscribe_Handle(&bench.table, handle, NULL, NULL, &id);
+    seen = method == 1 ? Parameters_Version(&bench.table, handle) : Parameters_Subscription_Generation(&bench.table, id);
+
+    start = now_ns();
+    for (count = 1; count <= BENCH_LOOKUPS; count++)
+    {
+        if (count % BENCH_POLL_CHANGE == 0)
+        {
+            value = (float)count;
+            Parameters_Set_by_handle(&bench.table, handle, PARAMETERS_TYPE_F32, &value);
+        }
+
+        switch (method)
+        {
+        case 0:
+            Parameters_Get_by_name(&bench.table, bench.names[number / 2], &index, &value);
+            changes += value != last;
+            last = value;
+            break;
+        case 1:
+            now = Parameters_Version(&bench.table, handle);
+            break;
+        default:
+            now = Parameters_Subscription_Generation(&bench.table, id);
+            break;
+        }
+        if (method != 0 && now != seen)
+        {
+            seen = now;
+            changes++;
+        }
+    }
+    cost = (now_ns() - start) / BENCH_LOOKUPS;
+
+    if (changes != BENCH_LOOKUPS / BENCH_POLL_CHANGE)
+    {
+        printf("poll saw %u of %u changes\n", changes, BENCH_LOOKUPS / BENCH_POLL_CHANGE);
+    }
+    bench_close(&bench);
+    free(config.version_map);
+    return cost;
+}
+
+/**
+ * @description:                                Mirror a table that changes a few parameters between syncs
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} delta                    send Parameters_Get_Changes or every Parameters_Get_by_index
+ * @param       {unsigned long} *sent           parameters sent per sync
+ * @return      {*}                             average nanoseconds per sync
+ * @note       :
+ */
+static double bench_mirror(unsigned int number, bool delta, unsigned long *sent)
+{
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_CHANGE_T changes[BENCH_MIRROR_BUFFER];
+    unsigned int count, round, since, until;
+    unsigned short index, filled;
+    char name[17];
+    float value;
+    double start, cost = 0;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = 1;
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.version_map = malloc(Parameters_Offset_Count((number + 1) * 21 + 1) * sizeof(unsigned int));
+    config.change_size = BENCH_MIRROR_LOG;
+    config.change_log = malloc(config.change_size * sizeof(PARAMETERS_LOG_T));
+    bench_open(&bench, number, &config);
+    since = Parameters_Generation(&bench.table);
+
+    *sent = 0;
+    for (round = 0; round < BENCH_MIRROR_ROUNDS; round++)
+    {
+        for (count = 0; count < BENCH_MIRROR_CHANGES; count++)
+        {
+            value = (float)(round + count);
+            Parameters_Chanege(&bench.table, bench.names[(round * 7919u + count * 104729u) % number], PARAMETERS_TYPE_F32, &value);
+        }
+
+        start = now_ns();
+        if (delta)
+        {
+            do
+            {
+                if (!Parameters_Get_Changes(&bench.table, since, changes, BENCH_MIRROR_BUFFER, &filled, &until))
+                {
+                    printf("mirror lost the changes\n");
+                }
+                *sent += filled;
+                since = until;
+            } while (filled == BENCH_MIRROR_BUFFER);
+        }
+        else
+        {
+            for (index = 0; Parameters_Get_by_index(&bench.table, index, name, &value) != 0; index++)
+            {
+                (*sent)++;
+            }
+        }
+        cost += now_ns() - start;
+    }
+
+    bench_close(&bench);
+    free(config.change_log);
+    free(config.version_map);
+    *sent /= BENCH_MIRROR_ROUNDS;
+    return cost / BENCH_MIRROR_ROUNDS;
+}
+
+/**
+ * @description:                                Answer PARAM_REQUEST_LIST over and over
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} stream                   Parameters_Mavlink_Stream or Parameters_Get_by_index and packing by hand
+ * @param       {bool} tombstone                the table holds a tombstone, Parameters_Get_by_index then walks the table
+ * @param       {unsigned int} *wrong           payloads that do not decode to the parameter, checked on the first answer
+ * @return      {*}                             PARAM_VALUE payloads per second
+ * @note       :                                The first answer is followed by a PARAM_SET of every parameter
+ */
+static double bench_mavlink(unsigned int number, bool stream, bool tombstone, unsigned int *wrong)
+{
+    unsigned long total = tombstone ? BENCH_MAVLINK_MESSAGES / 16 : BENCH_MAVLINK_MESSAGES;
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_MAVLINK_STREAM_T cursor;
+    unsigned char buffer[BENCH_MAVLINK_BUDGET];
+    unsigned char set[PARAMETERS_MAVLINK_SET_LEN];
+    unsigned char reply[PARAMETERS_MAVLINK_VALUE_LEN];
+    unsigned long messages = 0;
+    unsigned int size, offset, index = 0;
+    unsigned short count;
+    char name[17];
+    float value;
+    double start, cost;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = 1;
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.tombstone = tombstone;
+    bench_open(&bench, number, &config);
+    for (count = 0; count < number; count++)
+    {
+        value = (float)count;
+        Parameters_Chanege(&bench.table, bench.names[count], PARAMETERS_TYPE_F32, &value);
+    }
+    if (tombstone)
+    {
+        // the last cell of the block, deleted again
+        Parameters_Creat(&bench.table, "HOLE", PARAMETERS_TYPE_F32, &value);
+        Parameters_Del(&bench.table, "HOLE");
+    }
+
+    *wrong = 0;
+    start = now_ns();
+    while (messages < total)
+    {
+        Parameters_Mavlink_Start(&cursor, &bench.table, PARAMETERS_MAVLINK_BYTEWISE);
+        while (!Parameters_Mavlink_Done(&cursor))
+        {
+            if (stream)
+            {
+                size = Parameters_Mavlink_Stream(&cursor, buffer, sizeof(buffer));
+            }
+            else
+            {
+                for (size = 0; cursor.index < cursor.count && size + PARAMETERS_MAVLINK_VALUE_LEN <= sizeof(buffer);
+                     size += PARAMETERS_MAVLINK_VALUE_LEN, cursor.index++)
+                {
+                    memset(name, 0, sizeof(name));
+                    buffer[size + 24] = Parameters_Get_by_index(&bench.table, cursor.index, name, &value);
+                    memcpy(buffer + size, &value, 4);
+                    memcpy(buffer + size + 4, &cursor.count, 2);
+                    memcpy(buffer + size + 6, &cursor.index, 2);
+                    memcpy(buffer + size + 8, name, 16);
+                }
+            }
+
+            for (offset = 0; messages < number && offset < size; offset += PARAMETERS_MAVLINK_VALUE_LEN, index++)
+            {
+                memcpy(&value, buffer + offset, 4);
+                memcpy(&count, buffer + offset + 6, 2);
+                if (count != index || value != (float)index || buffer[offset + 24] != PARAMETERS_TYPE_F32 ||
+                    strncmp((char *)buffer + offset + 8, bench.names[index], 16) != 0)
+                {
+                    (*wrong)++;
+                }
+            }
+            messages += size / PARAMETERS_MAVLINK_VALUE_LEN;
+        }
+    }
+    cost = (now_ns() - start) / 1e9;
+
+    for (count = 0; count < number; count++)
+    {
+        value = -(float)count;
+        memset(set, 0, sizeof(set));
+        memcpy(set, &value, 4);
+        memcpy(set + 6, bench.names[count], strlen(bench.names[count]));
+        set[22] = PARAMETERS_TYPE_F32;
+        // MAVLink 2 drops the trailing zero bytes of a payload
+        for (size = sizeof(set); size > 1 && set[size - 1] == 0; size--)
+        {
+        }
+        if (!Parameters_Mavlink_Set(&bench.table, PARAMETERS_MAVLINK_BYTEWISE, set, size, reply) ||
+            memcmp(reply, set, 4) != 0 || Parameters_Get_by_index(&bench.table, count, name, &value) == 0 || value != -(float)count)
+        {
+            (*wrong)++;
+        }
+    }
+
+    bench_close(&bench);
+    return messages / cost;
+}
+
+/**
+ * @description:                                Register the parameters declared at build time and read one of them
+ * @param       {bool} declared                 Parameters_Register and a generated accessor, or one
+ *                                              Parameters_Creat and Parameters_Get_by_name per identifier
+ * @param       {bool} existing                 the parameters are already in ROM, as at every boot but the first
+ * @param       {double} *read_ns               nanoseconds per read of a float parameter
+ * @return      {*}                             microseconds per registration
+ * @note       :
+ */
+static double bench_declared(bool declared, bool existing, double *read_ns)
+{
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    unsigned int size = (BENCH_COUNT + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    unsigned int round, count;
+    unsigned short index;
+    float value = 0.0f;
+    double start, cost = 0.0;
+
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.hash_size = Parameters_Hash_Slots(size);
+    config.hash_block = malloc(config.hash_size * sizeof(unsigned short));
+    config.dirty_block = malloc(Parameters_Dirty_Size(size));
+    simulation_ROM_size = size + 64;
+    simulation_ROM = calloc(1, simulation_ROM_size);
+
+    for (round = 0; round < BENCH_DECLARED_BOOTS; round++)
+    {
+        if (!existing)
+        {
+            memset(simulation_ROM, 0, simulation_ROM_size);
+        }
+        memset(&table, 0, sizeof(table));
+        Parameters_Init_Ex(&table, "BENCH", RAM, 0, size, Read_From_ROM, Write_2_ROM, checksum, &config);
+
+        start = now_ns();
+        if (declared)
+        {
+            BENCH_Register(&table);
+        }
+        else
+        {
+            for (count = 0; count < BENCH_COUNT; count++)
+            {
+                Parameters_Creat(&table, (char *)BENCH_entries[count].name, BENCH_entries[count].type,
+                                 (void *)&BENCH_entries[count].default_value);
+            }
+        }
+        cost += now_ns() - start;
+    }
+
+    start = now_ns();
+    for (count = 0; count < BENCH_LOOKUPS; count++)
+    {
+        if (declared)
+        {
+            BENCH_Get_NAV_PARAM_04(&table, &value);
+        }
+        else
+        {
+            Parameters_Get_by_name(&table, "NAV_PARAM_04", &index, &value);
+        }
+    }
+    *read_ns = (now_ns() - start) / BENCH_LOOKUPS;
+    if (value != 0.5f)
+    {
+        printf("declared parameter read %f\n", value);
+    }
+
+    free(simulation_ROM);
+    free(config.dirty_block);
+    free(config.hash_block);
+    free(RAM);
+    return cost / BENCH_DECLARED_BOOTS / 1000.0;
+}
+
+/**
+ * @description:                                Time finding parameters among the tables of a registry
+ * @param       {unsigned int} number           number of tables of BENCH_REGISTRY_PARAMS parameters, at most 100
+ * @param       {bool} indexed                  through the global index or by searching each hashed table in turn
+ * @param       {double} *cost                  average nanoseconds per lookup
+ * @param       {unsigned long} *moved          ROM bytes written to grow the first table, which has to move
+ * @param       {unsigned long} *whole          ROM bytes of all tables, written by a full reflash
+ * @return      {*}                             false if the registry could not be set up or a lookup missed
+ * @note       :
+ */
+static bool bench_registry(unsigned int number, bool indexed, double *cost, unsigned long *moved, unsigned long *whole)
+{
+    PARAMETERS_REGISTRY_T registry;
+    PARAMETERS_REGISTRY_RECORD_T *records = malloc(number * sizeof(PARAMETERS_REGISTRY_RECORD_T));
+    PARAMETERS_REGISTRY_TABLE_T *tables = malloc(number * sizeof(PARAMETERS_REGISTRY_TABLE_T));
+    PARAMETERS_REGISTRY_SLOT_T *slots = NULL;
+    PARAMETERS_CB_T *table = calloc(number, sizeof(PARAMETERS_CB_T));
+    PARAMETERS_CONFIG_T *config = calloc(number, sizeof(PARAMETERS_CONFIG_T));
+    PARAMETERS_CB_T *found;
+    PARAMETERS_HANDLE_T handle;
+    unsigned int size = (BENCH_REGISTRY_PARAMS + 1) * 21 + 1;
+    unsigned int grown = BENCH_REGISTRY_GROWTH * size;
+    unsigned int slot_size = 1;
+    unsigned char **RAM = calloc(number, sizeof(unsigned char *));
+    unsigned char *large = malloc(grown);
+    unsigned int count, index, missed = 0;
+    char (*names)[17] = malloc(number * BENCH_REGISTRY_PARAMS * 17);
+    char tag[17], *name;
+    float value = 0.0f;
+    double start;
+    bool status;
+
+    *cost = 0;
+    *moved = 0;
+    *whole = 0;
+    while (slot_size < 2 * number * BENCH_REGISTRY_PARAMS)
+    {
+        slot_size <<= 1;
+    }
+    if (indexed)
+    {
+        slots = malloc(slot_size * sizeof(PARAMETERS_REGISTRY_SLOT_T));
+    }
+
+    simulation_ROM_size = (number + 1) * Parameters_ROM_Size(grown, NULL) + number * BENCH_REGISTRY_SECTOR + 4096;
+    simulation_ROM = calloc(1, simulation_ROM_size);
+    status = number <= 100 && records != NULL && tables != NULL && table != NULL && config != NULL && RAM != NULL &&
+             large != NULL && names != NULL && (!indexed || slots != NULL) && simulation_ROM != NULL &&
+             Parameters_Registry_Init(&registry, "BENCH", 0, simulation_ROM_size, BENCH_REGISTRY_SECTOR, records, tables,
+                                      number, slots, slot_size, Read_From_ROM, Write_2_ROM, checksum);
+
+    for (count = 0; status && count < number; count++)
+    {
+        RAM[count] = malloc(size);
+        config[count].hash_size = Parameters_Hash_Slots(grown);
+        config[count].hash_block = malloc(config[count].hash_size * sizeof(unsigned short));
+        snprintf(tag, sizeof(tag), "TABLE_%02u", count % 100);
+        status = RAM[count] != NULL && config[count].hash_block != NULL &&
+                 Parameters_Registry_Open(&registry, &table[count], tag, RAM[count], size, &config[count]);
+        for (index = 0; status && index < BENCH_REGISTRY_PARAMS; index++)
+        {
+            // interleaved, consecutive lookups go to different tables, at most 13 characters
+            name = names[index * number + count];
+            snprintf(name, 17, "T%02u_PARAM_%03u", count % 100, index % 1000);
+            status = Parameters_Creat(&table[count], name, PARAMETERS_TYPE_F32, &value) != NULL;
+        }
+        *whole += sizeof(PARAMETERS_TABLE_INFO_T) + Parameters_Used_Size(&table[count]);
+    }
+
+    if (status)
+    {
+        start = now_ns();
+        for (count = 0; count < BENCH_LOOKUPS; count++)
+        {
+            if (!Parameters_Registry_Find(&registry, names[count % (number * BENCH_REGISTRY_PARAMS)], &found, &handle))
+            {
+                missed++;
+            }
+        }
+        *cost = (now_ns() - start) / BENCH_LOOKUPS;
+
+        // the first table is followed by the second, growing it moves it after the last one
+        simulation_ROM_bytes = 0;
+        if (!Parameters_Registry_Resize(&registry, &table[0], large, grown, &config[0]) ||
+            !Parameters_Registry_Find(&registry, "T00_PARAM_000", &found, &handle) || found != &table[0])
+        {
+            missed++;
+        }
+        *moved = simulation_ROM_bytes;
+        if (missed != 0)
+        {
+            printf("registry lookups missed %u\n", missed);
+        }
+        status = missed == 0;
+    }
+    else
+    {
+        printf("registry of %u tables not set up\n", number);
+    }
+
+    for (count = 0; RAM != NULL && config != NULL && count < number; count++)
+    {
+        free(config[count].hash_block);
+        free(RAM[count]);
+    }
+    free(simulation_ROM);
+    free(large);
+    free(names);
+    free(RAM);
+    free(config);
+    free(table);
+    free(slots);
+    free(tables);
+    free(records);
+    return status;
+}
+
+// checkout functions compared by bench_checkout and bench_verify
+typedef enum
+{
+    BENCH_CHECKOUT_SUM = 0,
+    BENCH_CHECKOUT_SLICE8,
+    BENCH_CHECKOUT_CRC32C,
+    BENCH_CHECKOUTS,
+} BENCH_CHECKOUT_T;
+
+static const char *const bench_checkout_name[BENCH_CHECKOUTS] = {"byte sum", "slice-by-8", "CRC32C"};
+
+static PARAMETERS_CHECK_T bench_slice8(unsigned char *data, unsigned int size)
+{
+    return (PARAMETERS_CHECK_T)Parameters_CRC32C_Slice8(0, data, size);
+}
+
+static PARAMETERS_CHECK_T (*const bench_checkout_function[BENCH_CHECKOUTS])(unsigned char *, unsigned int) = {
+    checksum, bench_slice8, Parameters_Checkout_CRC32C};
+
+/**
+ * @description:                                Throughput of a checkout function
+ * @param       {unsigned int} size             bytes passed to each call
+ * @param       {BENCH_CHECKOUT_T} kernel       checkout function
+ * @return      {*}                             millions of bytes per second
+ * @note       :                                BENCH_CHECKOUT_BYTES bytes are checked in calls of size bytes
+ */
+static double bench_checkout(unsigned int size, BENCH_CHECKOUT_T kernel)
+{
+    unsigned char *data = malloc(size);
+    volatile PARAMETERS_CHECK_T check = 0;
+    unsigned long done;
+    unsigned int count;
+    double start;
+
+    for (count = 0; count < size; count++)
+    {
+        data[count] = (unsigned char)(count * 7919u >> 3);
+    }
+
+    start = now_ns();
+    for (done = 0; done < BENCH_CHECKOUT_BYTES; done += size)
+    {
+        check += bench_checkout_function[kernel](data, size);
+    }
+    start = now_ns() - start;
+
+    free(data);
+    return done / start * 1000.0;
+}
+
+/**
+ * @description:                                Time Parameters_Init of a whole table check and its detection of a fault
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {BENCH_CHECKOUT_T} kernel       checkout function of the table
+ * @param       {bool} *detected                Parameters_Init refused the table after two bytes of a cell were swapped
+ * @return      {*}                             microseconds per Parameters_Init
+ * @note       :
+ */
+static double bench_verify(unsigned int number, BENCH_CHECKOUT_T kernel, bool *detected)
+{
+    PARAMETERS_CB_T table;
+    unsigned int size = (number + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    unsigned char swap;
+    char name[17];
+    unsigned int count;
+    float value = 1.5f;
+    double start;
+
+    simulation_ROM_size = size + 64;
+    simulation_ROM = calloc(1, simulation_ROM_size);
+    memset(&table, 0, sizeof(table));
+    Parameters_Init(&table, "BENCH", RAM, 0, size, Read_From_ROM, Write_2_ROM, bench_checkout_function[kernel]);
+    Parameters_Begin(&table);
+    for (count = 0; count < number; count++)
+    {
+        bench_name(name, count);
+        Parameters_Creat(&table, name, PARAMETERS_TYPE_F32, &value);
+    }
+    Parameters_Commit(&table);
+
+    start = now_ns();
+    for (count = 0; count < BENCH_SUITE_INITS; count++)
+    {
+        memset(&table, 0, sizeof(table));
+        Parameters_Init(&table, "BENCH", RAM, 0, size, Read_From_ROM, Write_2_ROM, bench_checkout_function[kernel]);
+    }
+    start = (now_ns() - start) / BENCH_SUITE_INITS / 1000.0;
+
+    // the first identifier reads "APRAM_00000", the sum of its bytes is the same
+    swap = simulation_ROM[sizeof(PARAMETERS_TABLE_INFO_T)];
+    simulation_ROM[sizeof(PARAMETERS_TABLE_INFO_T)] = simulation_ROM[sizeof(PARAMETERS_TABLE_INFO_T) + 1];
+    simulation_ROM[sizeof(PARAMETERS_TABLE_INFO_T) + 1] = swap;
+    memset(&table, 0, sizeof(table));
+    *detected = !Parameters_Init(&table, "BENCH", RAM, 0, size, Read_From_ROM, Write_2_ROM, bench_checkout_function[kernel]);
+
+    free(simulation_ROM);
+    free(RAM);
+    return start;
+}
+
+/**
+ * @description:                                Time Parameters_Set_by_handle on one parameter of a table
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {PARAMETERS_CHECK_MODE_T} mode  check mode of the table
+ * @return      {*}                             average nanoseconds per write
+ * @note       :
+ */
+static double bench_write(unsigned int number, PARAMETERS_CHECK_MODE_T mode)
+{
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_HANDLE_T handle;
+    unsigned int count;
+    float value;
+    double start, cost;
+
+    memset(&config, 0, sizeof(config));
+    config.check_mode = mode;
+    bench_open(&bench, number, &config);
+    Parameters_Get_Handle(&bench.table, bench.names[number / 2], &handle);
+
+    start = now_ns();
+    for (count = 0; count < BENCH_WRITES; count++)
+    {
+        value = (float)count;
+        Parameters_Set_by_handle(&bench.table, handle, PARAMETERS_TYPE_F32, &value);
+    }
+    cost = (now_ns() - start) / BENCH_WRITES;
+
+    bench_close(&bench);
+    return cost;
+}
+
+/**
+ * @description:                                Count ROM writes of a ground station pushing every parameter of a table
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} batched                  push inside Parameters_Begin / Parameters_Commit
+ * @param       {unsigned int} *saved           writes saved reported by the module
+ * @return      {*}                             Write_2_ROM calls of the push
+ * @note       :
+ */
+static unsigned int bench_push(unsigned int number, bool batched, unsigned int *saved)
+{
+    static unsigned char enable;
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    unsigned int count;
+    float value = 1.0f;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = 1;
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.dirty_block = &enable;
+    bench_open(&bench, number, &config);
+
+    simulation_ROM_writes = 0;
+    if (batched)
+    {
+        Parameters_Begin(&bench.table);
+    }
+    for (count = 0; count < number; count++)
+    {
+        Parameters_Chanege(&bench.table, bench.names[count], PARAMETERS_TYPE_F32, &value);
+    }
+    if (batched)
+    {
+        Parameters_Commit(&bench.table);
+    }
+    *saved = bench.table.saved_writes;
+
+    bench_close(&bench);
+    return simulation_ROM_writes;
+}
+
+typedef enum
+{
+    BENCH_LOAD_CHANGE = 0,
+    BENCH_LOAD_BATCH,
+    BENCH_LOAD_IMPORT,
+    BENCH_LOAD_BANKS,
+    BENCH_LOADS,
+} BENCH_LOAD_T;
+
+static const char *const bench_load_name[BENCH_LOADS] = {"Chanege", "batch", "Import", "Import banks"};
+
+/**
+ * @description:                                Load a new value into every parameter of a table
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {BENCH_LOAD_T} method           one change per parameter, a batch of them or a snapshot
+ * @param       {unsigned int} cut              writes of the load before the power is cut, 0 for none
+ * @param       {unsigned long} *bytes          ROM bytes written by the load
+ * @param       {unsigned int} *snapshot        bytes of the snapshot
+ * @param       {const char} **reload           parameters found by a boot after the load: old, new or lost
+ * @return      {*}                             Write_2_ROM calls of the load
+ * @note       :                                The snapshot is exported from the same table before its values are reset
+ */
+static unsigned int bench_load(unsigned int number, BENCH_LOAD_T method, unsigned int cut, unsigned long *bytes,
+                               unsigned int *snapshot, const char **reload)
+{
+    static unsigned char enable;
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_CB_T table;
+    unsigned char *buffer;
+    unsigned char *RAM;
+    unsigned int length, count, writes;
+    unsigned short applied;
+    float value;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = 1;
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.dirty_block = &enable;
+    config.banks = method == BENCH_LOAD_BANKS;
+    bench_open(&bench, number, &config);
+    RAM = malloc(bench.size);
+
+    Parameters_Begin(&bench.table);
+    for (count = 0; count < number; count++)
+    {
+        value = (float)(count + 1);
+        Parameters_Chanege(&bench.table, bench.names[count], PARAMETERS_TYPE_F32, &value);
+    }
+    Parameters_Commit(&bench.table);
+    Parameters_Export(&bench.table, NULL, 0, &length);
+    buffer = malloc(length);
+    Parameters_Export(&bench.table, buffer, length, snapshot);
+
+    value = 0.0f;
+    Parameters_Begin(&bench.table);
+    for (count = 0; count < number; count++)
+    {
+        Parameters_Chanege(&bench.table, bench.names[count], PARAMETERS_TYPE_F32, &value);
+    }
+    Parameters_Commit(&bench.table);
+
+    simulation_ROM_writes = 0;
+    simulation_ROM_bytes = 0;
+    simulation_ROM_cut = cut != 0 ? cut + 1 : 0;
+    if (method == BENCH_LOAD_CHANGE || method == BENCH_LOAD_BATCH)
+    {
+        if (method == BENCH_LOAD_BATCH)
+        {
+            Parameters_Begin(&bench.table);
+        }
+        for (count = 0; count < number; count++)
+        {
+            value = (float)(count + 1);
+            Parameters_Chanege(&bench.table, bench.names[count], PARAMETERS_TYPE_F32, &value);
+        }
+        if (method == BENCH_LOAD_BATCH)
+        {
+            Parameters_Commit(&bench.table);
+        }
+    }
+    else
+    {
+        Parameters_Import(&bench.table, buffer, length, &applied);
+    }
+    simulation_ROM_cut = 0;
+    writes = simulation_ROM_writes;
+    *bytes = simulation_ROM_bytes;
+
+    // boot on what reached ROM
+    memset(&table, 0, sizeof(table));
+    value = -1.0f;
+    if (Parameters_Init_Ex(&table, "BENCH", RAM, 0, bench.size, Read_From_ROM, Write_2_ROM, checksum, &bench.config))
+    {
+        Parameters_Get_by_name(&table, bench.names[number - 1], &applied, &value);
+    }
+    *reload = value == (float)number ? "new" : value == 0.0f ? "old" : "lost";
+
+    free(buffer);
+    free(RAM);
+    bench_close(&bench);
+    return writes;
+}
+
+/**
+ * @description:                                Count ROM writes of deleting the first parameter of a table
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} tombstone                delete by tombstone or by moving the following cells
+ * @return      {*}                             Write_2_ROM calls of the delete
+ * @note       :
+ */
+static unsigned int bench_delete(unsigned int number, bool tombstone)
+{
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    unsigned int writes;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = 1;
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.tombstone = tombstone;
+    bench_open(&bench, number, &config);
+
+    simulation_ROM_writes = 0;
+    Parameters_Del(&bench.table, bench.names[0]);
+    writes = simulation_ROM_writes;
+
+    bench_close(&bench);
+    return writes;
+}
+
+/**
+ * @description:                                Erase cycles per flash sector when one parameter is changed repeatedly
+ * @param       {bool} journal                  journal storage or the in-place layout
+ * @param       {unsigned int} *min             fewest erases of a sector
+ * @param       {unsigned int} *max             most erases of a sector
+ * @param       {unsigned long} *total          erases of the device
+ * @return      {*}                             the table reloads with the last value
+ * @note       :                                The in-place layout rewrites through a read-erase-program driver
+ */
+static bool bench_wear(bool journal, unsigned int *min, unsigned int *max, unsigned long *total)
+{
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_HANDLE_T handle;
+    unsigned int size = 65 * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    unsigned char journal_map[65];
+    char name[17];
+    unsigned int count;
+    unsigned short index;
+    float value = 0.0f;
+    bool status;
+
+    Sim_Flash_Open(BENCH_WEAR_SECTOR * BENCH_WEAR_SECTORS, BENCH_WEAR_SECTOR);
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    if (journal)
+    {
+        config.journal_size = BENCH_WEAR_SECTOR * BENCH_WEAR_SECTORS;
+        config.journal_sector = BENCH_WEAR_SECTOR;
+        config.journal_map = journal_map;
+        config.Erase_ROM = Sim_Flash_Erase;
+    }
+
+    memset(&table, 0, sizeof(table));
+    Parameters_Init_Ex(&table, "WEAR", RAM, 0, size, Sim_Flash_Read,
+                       journal ? Sim_Flash_Write : Sim_Flash_Write_Erasing, checksum, &config);
+    for (count = 0; count < 64; count++)
+    {
+        bench_name(name, count);
+        Parameters_Creat(&table, name, PARAMETERS_TYPE_F32, &value);
+    }
+    Parameters_Get_Handle(&table, "PARAM_00010", &handle);
+
+    Sim_Flash_Reset_Counters();
+    for (count = 0; count < BENCH_WEAR_WRITES; count++)
+    {
+        value = (float)count;
+        Parameters_Set_by_handle(&table, handle, PARAMETERS_TYPE_F32, &value);
+    }
+    Sim_Flash_Wear(min, max, total);
+
+    memset(&table, 0, sizeof(table));
+    status = Parameters_Init_Ex(&table, "WEAR", RAM, 0, size, Sim_Flash_Read,
+                                journal ? Sim_Flash_Write : Sim_Flash_Write_Erasing, checksum, &config);
+    status &= table.table_info.used_number == 64;
+    status &= Parameters_Get_by_name(&table, "PARAM_00010", &index, &value) == PARAMETERS_TYPE_F32 &&
+              value == (float)(BENCH_WEAR_WRITES - 1);
+
+    Sim_Flash_Close();
+    free(RAM);
+    return status;
+}
+
+/**
+ * @description:                                Change parameters of a table kept in a file
+ * @param       {PARAMETERS_FILE_MODE_T} mode   pread / pwrite or mmap
+ * @param       {unsigned int} window_us        group commit window, 0 to sync every write
+ * @param       {unsigned long} *syncs          fdatasync / msync calls
+ * @return      {*}                             changes per second, until the last one is durable
+ * @note       :
+ */
+static double bench_file(PARAMETERS_FILE_MODE_T mode, unsigned int window_us, unsigned long *syncs)
+{
+    PARAMETERS_FILE_T file;
+    PARAMETERS_CB_T table;
+    unsigned int size = (BENCH_FILE_PARAMS + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    char name[17];
+    unsigned int count, value = 0;
+    double start;
+
+    unlink(BENCH_FILE_PATH);
+    Parameters_File_Open(&file, BENCH_FILE_PATH, size + 64, mode, window_us);
+    memset(&table, 0, sizeof(table));
+    Parameters_Init(&table, "FILE", RAM, 0, size, Parameters_File_Read, Parameters_File_Write, Parameters_Checkout_CRC32C);
+    for (count = 0; count < BENCH_FILE_PARAMS; count++)
+    {
+        bench_name(name, count);
+        Parameters_Creat(&table, name, PARAMETERS_TYPE_UINT32, &value);
+    }
+    Parameters_File_Sync(&file);
+    *syncs = file.syncs;
+
+    start = now_ns();
+    for (count = 0; count < BENCH_FILE_CHANGES; count++)
+    {
+        bench_name(name, count % BENCH_FILE_PARAMS);
+        value = count;
+        Parameters_Chanege(&table, name, PARAMETERS_TYPE_UINT32, &value);
+    }
+    Parameters_File_Sync(&file);
+    start = now_ns() - start;
+    *syncs = file.syncs - *syncs;
+
+    Parameters_File_Close(&file);
+    unlink(BENCH_FILE_PATH);
+    free(RAM);
+    return BENCH_FILE_CHANGES / start * 1e9;
+}
+
+// storage of the tables killed by bench_crash
+typedef enum
+{
+    BENCH_CRASH_IN_PLACE = 0,
+    BENCH_CRASH_JOURNAL,
+    BENCH_CRASH_BANKS,
+    BENCH_CRASHES,
+} BENCH_CRASH_T;
+
+static const char *const bench_crash_name[BENCH_CRASHES] = {"in place", "journal", "banks"};
+
+/**
+ * @description:                                Open the table of bench_crash on the open file
+ * @param       {PARAMETERS_CB_T} *table        table to initialize
+ * @param       {PARAMETERS_FILE_T} *file       open file
+ * @param       {BENCH_CRASH_T} storage         storage of the table
+ * @param       {unsigned char} **RAM           RAM block, mapped from the file for an in place table in the mmap mode
+ * @param       {unsigned char} *journal_map    one byte per cell
+ * @return      {*}                             Parameters_Init_Ex succeeded
+ * @note       :
+ */
+static bool bench_crash_open(PARAMETERS_CB_T *table, PARAMETERS_FILE_T *file, BENCH_CRASH_T storage, unsigned char **RAM,
+                             unsigned char *journal_map)
+{
+    PARAMETERS_CONFIG_T config;
+
+    memset(&config, 0, sizeof(config));
+    config.journal_size = storage == BENCH_CRASH_JOURNAL ? BENCH_CRASH_JOURNAL_SIZE : 0;
+    config.journal_sector = BENCH_CRASH_JOURNAL_SIZE / 8;
+    config.journal_map = journal_map;
+    config.Erase_ROM = Parameters_File_Erase;
+    config.banks = storage == BENCH_CRASH_BANKS;
+    config.mapped = storage == BENCH_CRASH_IN_PLACE && file->mode == PARAMETERS_FILE_MMAP;
+    *RAM = config.mapped ? Parameters_File_Map(file, 0, BENCH_CRASH_SIZE) : malloc(BENCH_CRASH_SIZE);
+
+    memset(table, 0, sizeof(PARAMETERS_CB_T));
+    return *RAM != NULL && Parameters_Init_Ex(table, "CRASH", *RAM, 0, BENCH_CRASH_SIZE, Parameters_File_Read,
+                                              Parameters_File_Write, Parameters_Checkout_CRC32C, &config);
+}
+
+/**
+ * @description:                                Write the table of bench_crash until killed
+ * @param       {PARAMETERS_FILE_MODE_T} mode   pread / pwrite or mmap
+ * @param       {BENCH_CRASH_T} storage         storage of the table
+ * @param       {int} ready                     pipe written once every parameter exists
+ * @return      {*}                             does not return
+ * @note       :                                Runs in a child process. In place and journal tables change the
+ *                                              parameters in order to the round number, banks import all of them at once
+ */
+static void bench_crash_child(PARAMETERS_FILE_MODE_T mode, BENCH_CRASH_T storage, int ready)
+{
+    PARAMETERS_FILE_T file;
+    PARAMETERS_CB_T table;
+    unsigned char journal_map[BENCH_CRASH_PARAMS + 1];
+    unsigned char *snapshot[2];
+    unsigned char *RAM;
+    unsigned int length[2];
+    unsigned short applied;
+    unsigned int count, round;
+    char name[17];
+
+    if (!Parameters_File_Open(&file, BENCH_FILE_PATH, BENCH_CRASH_ROM, mode, BENCH_FILE_WINDOW_US) ||
+        !bench_crash_open(&table, &file, storage, &RAM, journal_map))
+    {
+        _exit(1);
+    }
+    for (round = 1; round <= 2; round++)
+    {
+        for (count = 0; count < BENCH_CRASH_PARAMS; count++)
+        {
+            bench_name(name, count);
+            Parameters_Creat(&table, name, PARAMETERS_TYPE_UINT32, &round);
+            Parameters_Chanege(&table, name, PARAMETERS_TYPE_UINT32, &round);
+        }
+        Parameters_Export(&table, NULL, 0, &length[round - 1]);
+        snapshot[round - 1] = malloc(length[round - 1]);
+        Parameters_Export(&table, snapshot[round - 1], length[round - 1], &length[round - 1]);
+    }
+    if (write(ready, "", 1) != 1)
+    {
+        _exit(1);
+    }
+
+    for (round = 3; true; round++)
+    {
+        if (storage == BENCH_CRASH_BANKS)
+        {
+            Parameters_Import(&table, snapshot[round & 1], length[round & 1], &applied);
+            continue;
+        }
+        for (count = 0; count < BENCH_CRASH_PARAMS; count++)
+        {
+            bench_name(name, count);
+            Parameters_Chanege(&table, name, PARAMETERS_TYPE_UINT32, &round);
+        }
+    }
+}
+
+/**
+ * @description:                                Kill a process writing a table kept in a file and open the table again
+ * @param       {PARAMETERS_FILE_MODE_T} mode   pread / pwrite or mmap
+ * @param       {BENCH_CRASH_T} storage         storage of the table
+ * @return      {*}                             runs whose table opened with a state the writer went through
+ * @note       :                                In place and journal tables must hold the values of one round for the
+ *                                              first parameters and of the round before for the others, banks the
+ *                                              values of one import
+ */
+static unsigned int bench_crash(PARAMETERS_FILE_MODE_T mode, BENCH_CRASH_T storage)
+{
+    PARAMETERS_FILE_T file;
+    PARAMETERS_CB_T table;
+    unsigned char journal_map[BENCH_CRASH_PARAMS + 1];
+    unsigned char *RAM;
+    unsigned int count, run, value, first, last;
+    unsigned int consistent = 0;
+    unsigned short index;
+    char name[17];
+    int ready[2];
+    pid_t child;
+    bool status;
+
+    for (run = 0; run < BENCH_CRASH_RUNS; run++)
+    {
+        unlink(BENCH_FILE_PATH);
+        if (pipe(ready) != 0)
+        {
+            break;
+        }
+        child = fork();
+        if (child == 0)
+        {
+            close(ready[0]);
+            bench_crash_child(mode, storage, ready[1]);
+        }
+        close(ready[1]);
+        status = child > 0 && read(ready[0], name, 1) == 1;
+        close(ready[0]);
+        if (child > 0)
+        {
+            usleep(BENCH_CRASH_MIN_US + (run * 7919u) % (BENCH_CRASH_MAX_US - BENCH_CRASH_MIN_US));
+            kill(child, SIGKILL);
+            waitpid(child, NULL, 0);
+        }
+        if (!status || !Parameters_File_Open(&file, BENCH_FILE_PATH, BENCH_CRASH_ROM, mode, 0))
+        {
+            continue;
+        }
+
+        status = bench_crash_open(&table, &file, storage, &RAM, journal_map) &&
+                 table.table_info.used_number == BENCH_CRASH_PARAMS;
+        first = last = 0;
+        for (count = 0; status && count < BENCH_CRASH_PARAMS; count++)
+        {
+            bench_name(name, count);
+            status = Parameters_Get_by_name(&table, name, &index, &value) == PARAMETERS_TYPE_UINT32;
+            first = count == 0 ? value : first;
+            status = status && (storage == BENCH_CRASH_BANKS ? value == first
+                                                             : value <= (count == 0 ? value : last) && value + 1 >= first);
+            last = value;
+        }
+        consistent += status;
+
+        if (RAM != NULL && storage == BENCH_CRASH_IN_PLACE && mode == PARAMETERS_FILE_MMAP)
+        {
+            Parameters_File_Unmap(RAM, BENCH_CRASH_SIZE);
+        }
+        else
+        {
+            free(RAM);
+        }
+        Parameters_File_Close(&file);
+    }
+    unlink(BENCH_FILE_PATH);
+    return consistent;
+}
+
+/**
+ * @description:                                Startup time of a table on a flash with per-call latency
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {unsigned int} max_transfer     largest read of the init, 0 for no limit
+ * @param       {unsigned long} *calls          Read_From_ROM calls of the init
+ * @return      {*}                             modelled startup time in microseconds
+ * @note       :
+ */
+static double bench_startup(unsigned int number, unsigned int max_transfer, unsigned long *calls)
+{
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    unsigned int size = (number + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    char name[17];
+    unsigned int count;
+    float value = 0.0f;
+    double cost;
+
+    Sim_Flash_Open(((size + 64) / 4096 + 1) * 4096, 4096);
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.dirty_block = malloc(Parameters_Dirty_Size(size));
+
+    memset(&table, 0, sizeof(table));
+    Parameters_Init_Ex(&table, "BOOT", RAM, 0, size, Sim_Flash_Read, Sim_Flash_Write_Erasing, checksum, &config);
+    Parameters_Begin(&table);
+    for (count = 0; count < number; count++)
+    {
+        bench_name(name, count);
+        Parameters_Creat(&table, name, PARAMETERS_TYPE_F32, &value);
+    }
+    Parameters_Commit(&table);
+
+    config.max_transfer = max_transfer;
+    Sim_Flash_Reset_Counters();
+    sim_flash.call_latency_ns = BENCH_CALL_LATENCY_NS;
+    sim_flash.byte_cost_ns = BENCH_BYTE_COST_NS;
+    memset(&table, 0, sizeof(table));
+    if (!Parameters_Init_Ex(&table, "BOOT", RAM, 0, size, Sim_Flash_Read, Sim_Flash_Write_Erasing, checksum, &config) ||
+        table.table_info.used_number != number)
+    {
+        printf("startup of %u parameters failed\n", number);
+    }
+    cost = sim_flash.elapsed_ns / 1000.0;
+    *calls = sim_flash.read_calls;
+
+    Sim_Flash_Close();
+    free(config.dirty_block);
+    free(RAM);
+    return cost;
+}
+
+/**
+ * @description:                                Time hashed lookups on a table of mostly small parameters
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} packed                   packed or fixed size cells
+ * @param       {unsigned int} *bytes           bytes of ROM taken by the cells
+ * @return      {*}                             average nanoseconds per lookup
+ * @note       :                                6 in 10 parameters are uint8, 3 uint16, 1 a float, a double where packed
+ */
+static double bench_packed(unsigned int number, bool packed, unsigned int *bytes)
+{
+    static const PARAMETERS_TYPE_T mix[10] = {PARAMETERS_TYPE_UINT8, PARAMETERS_TYPE_UINT16, PARAMETERS_TYPE_UINT8,
+                                              PARAMETERS_TYPE_UINT8, PARAMETERS_TYPE_UINT16, PARAMETERS_TYPE_UINT8,
+                                              PARAMETERS_TYPE_F32, PARAMETERS_TYPE_UINT8, PARAMETERS_TYPE_UINT16,
+                                              PARAMETERS_TYPE_UINT8};
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_TYPE_T type;
+    unsigned int size = (number + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    char(*names)[17] = malloc(number * 17);
+    unsigned int count;
+    unsigned short index;
+    double value = 0.0;
+    double start, cost;
+
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.hash_size = Parameters_Hash_Slots(size);
+    config.hash_block = malloc(config.hash_size * sizeof(unsigned short));
+    config.offset_map = packed ? malloc(Parameters_Offset_Count(size) * sizeof(unsigned short)) : NULL;
+    simulation_ROM_size = size + 64;
+    simulation_ROM = calloc(1, simulation_ROM_size);
+
+    memset(&table, 0, sizeof(table));
+    Parameters_Init_Ex(&table, "BENCH", RAM, 0, size, Read_From_ROM, Write_2_ROM, checksum, &config);
+    for (count = 0; count < number; count++)
+    {
+        bench_name(names[count], count);
+        type = mix[count % 10] == PARAMETERS_TYPE_F32 && packed ? PARAMETERS_TYPE_F64 : mix[count % 10];
+        Parameters_Creat(&table, names[count], type, &value);
+    }
+    *bytes = packed ? config.offset_map[table.table_info.used_number] : table.table_info.used_number * 21;
+
+    start = now_ns();
+    for (count = 0; count < BENCH_LOOKUPS; count++)
+    {
+        if (Parameters_Get_by_name(&table, names[(count * 7919u) % number], &index, &value) == 0)
+        {
+            printf("lookup %s failed\n", names[(count * 7919u) % number]);
+        }
+    }
+    cost = (now_ns() - start) / BENCH_LOOKUPS;
+
+    free(simulation_ROM);
+    free(config.offset_map);
+    free(config.hash_block);
+    free(names);
+    free(RAM);
+    return cost;
+}
+
+static double bench_first(unsigned int number, unsigned short lazy_page, bool whole, unsigned long *calls)
+{
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    unsigned int size = (number + 1) * 21 + 1;
+    unsigned int pages = Parameters_Page_Count(size, lazy_page);
+    unsigned char *RAM = malloc(size);
+    char name[17];
+    unsigned int count;
+    unsigned short index;
+    float value = 0.0f;
+    double cost;
+
+    Sim_Flash_Open(((size + 64 + pages * 2) / 4096 + 1) * 4096, 4096);
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.dirty_block = malloc(Parameters_Dirty_Size(size));
+    config.hash_size = Parameters_Hash_Slots(size);
+    config.hash_block = malloc(config.hash_size * sizeof(unsigned short));
+    config.lazy_page = lazy_page;
+    config.page_check = malloc(pages * sizeof(PARAMETERS_CHECK_T) + 1);
+    config.page_loaded = malloc(pages / 8 + 1);
+
+    memset(&table, 0, sizeof(table));
+    Parameters_Init_Ex(&table, "BOOT", RAM, 0, size, Sim_Flash_Read, Sim_Flash_Write_Erasing, checksum, &config);
+    Parameters_Begin(&table);
+    for (count = 0; count < number; count++)
+    {
+        bench_name(name, count);
+        Parameters_Creat(&table, name, PARAMETERS_TYPE_F32, &value);
+    }
+    Parameters_Commit(&table);
+
+    Sim_Flash_Reset_Counters();
+    sim_flash.call_latency_ns = BENCH_CALL_LATENCY_NS;
+    sim_flash.byte_cost_ns = BENCH_BYTE_COST_NS;
+    memset(&table, 0, sizeof(table));
+    if (!Parameters_Init_Ex(&table, "BOOT", RAM, 0, size, Sim_Flash_Read, Sim_Flash_Write_Erasing, checksum, &config))
+    {
+        printf("lazy startup of %u parameters failed\n", number);
+    }
+    bench_name(name, 0);
+    if (Parameters_Get_by_name(&table, name, &index, &value) != PARAMETERS_TYPE_F32)
+    {
+        printf("first parameter of %u parameters missing\n", number);
+    }
+    for (count = 0; whole && count < number; count++)
+    {
+        Parameters_Get_by_index(&table, count, name, &value);
+    }
+    cost = sim_flash.elapsed_ns / 1000.0;
+    *calls = sim_flash.read_calls;
+
+    Sim_Flash_Close();
+    free(config.page_loaded);
+    free(config.page_check);
+    free(config.hash_block);
+    free(config.dirty_block);
+    free(RAM);
+    return cost;
+}
+
+typedef struct
+{
+    PARAMETERS_CB_T table;
+    volatile bool stop;
+    unsigned long writes;
+    unsigned long reads[BENCH_STRESS_READERS];
+    unsigned long torn[BENCH_STRESS_READERS];
+} BENCH_STRESS_T;
+
+static BENCH_STRESS_T stress;
+
+/**
+ * @description:                                Keep changing, deleting and creating parameters
+ * @param       {void} *arg                     unused
+ * @return      {*}
+ * @note       :                                The value of SEQ_k always holds k in its upper 16 bits
+ */
+static void *stress_writer(void *arg)
+{
+    unsigned int seed = 1;
+    unsigned int key, value;
+    char name[17];
+
+    (void)arg;
+    while (!stress.stop)
+    {
+        key = rand_r(&seed) % BENCH_STRESS_PARAMS;
+        value = (key << 16) | (stress.writes & 0xFFFF);
+        snprintf(name, sizeof(name), "SEQ_%03u", key);
+        if (stress.writes & 1)
+        {
+            Parameters_Chanege(&stress.table, name, PARAMETERS_TYPE_UINT32, &value);
+        }
+        else
+        {
+            // moves every cell behind it, the hardest change for a reader
+            Parameters_Del(&stress.table, name);
+            Parameters_Creat(&stress.table, name, PARAMETERS_TYPE_UINT32, &value);
+        }
+        stress.writes++;
+    }
+    return NULL;
+}
+
+/**
+ * @description:                                Read parameters by name and by index and check the pairs
+ * @param       {void} *arg                     index of the reader
+ * @return      {*}
+ * @note       :
+ */
+static void *stress_reader(void *arg)
+{
+    unsigned int reader = (unsigned int)(uintptr_t)arg;
+    unsigned int seed = reader + 7;
+    unsigned int key, value;
+    unsigned short index;
+    char name[17];
+
+    while (!stress.stop)
+    {
+        key = rand_r(&seed) % BENCH_STRESS_PARAMS;
+        memset(name, 0, sizeof(name));
+        if (key & 1)
+        {
+            snprintf(name, sizeof(name), "SEQ_%03u", key);
+            if (Parameters_Get_by_name(&stress.table, name, &index, &value) == 0)
+            {
+                continue;
+            }
+        }
+        else if (Parameters_Get_by_index(&stress.table, key, name, &value) != PARAMETERS_TYPE_UINT32)
+        {
+            continue;
+        }
+
+        stress.reads[reader]++;
+        if (strncmp(name, "SEQ_", 4) != 0 || (value >> 16) != (unsigned int)atoi(name + 4))
+        {
+            stress.torn[reader]++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @description:                                One writer against concurrent readers
+ * @param       {bool} seqlock                  readers retry through the seqlock or read unprotected
+ * @param       {unsigned long} *reads          reads done
+ * @param       {unsigned long} *torn           reads that returned a name and value from different states
+ * @return      {*}                             writes done
+ * @note       :
+ */
+static unsigned long bench_stress(bool seqlock, unsigned long *reads, unsigned long *torn)
+{
+    PARAMETERS_CONFIG_T config;
+    pthread_t writer, readers[BENCH_STRESS_READERS];
+    unsigned int size = (BENCH_STRESS_PARAMS + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    struct timespec wait = {BENCH_STRESS_MS / 1000, (BENCH_STRESS_MS % 1000) * 1000000L};
+    unsigned int count, value;
+    char name[17];
+
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.hash_size = Parameters_Hash_Slots(size);
+    config.hash_block = malloc(config.hash_size * sizeof(unsigned short));
+    config.seqlock = seqlock;
+    simulation_ROM_size = size + 64;
+    simulation_ROM = calloc(1, simulation_ROM_size);
+
+    memset(&stress, 0, sizeof(stress));
+    Parameters_Init_Ex(&stress.table, "STRESS", RAM, 0, size, Read_From_ROM, Write_2_ROM, checksum, &config);
+    for (count = 0; count < BENCH_STRESS_PARAMS; count++)
+    {
+        value = count << 16;
+        snprintf(name, sizeof(name), "SEQ_%03u", count);
+        Parameters_Creat(&stress.table, name, PARAMETERS_TYPE_UINT32, &value);
+    }
+
+    pthread_create(&writer, NULL, stress_writer, NULL);
+    for (count = 0; count < BENCH_STRESS_READERS; count++)
+    {
+        pthread_create(&readers[count], NULL, stress_reader, (void *)(uintptr_t)count);
+    }
+    nanosleep(&wait, NULL);
+    stress.stop = true;
+    pthread_join(writer, NULL);
+
+    *reads = 0;
+    *torn = 0;
+    for (count = 0; count < BENCH_STRESS_READERS; count++)
+    {
+        pthread_join(readers[count], NULL);
+        *reads += stress.reads[count];
+        *torn += stress.torn[count];
+    }
+
+    free(simulation_ROM);
+    free(config.hash_block);
+    free(RAM);
+    return stress.writes;
+}
+
+/**
+ * @description:                                Print the kill and reopen runs of every file mode and storage
+ * @return      {*}                             false if a journal or banks table opened inconsistent
+ * @note       :                                In place tables are expected to lose some runs
+ */
+static bool bench_crash_table(void)
+{
+    unsigned int crash_runs[2][BENCH_CRASHES];
+    bool consistent[2];
+    PARAMETERS_FILE_MODE_T mode;
+    BENCH_CRASH_T crash;
+
+    printf("\nwriter killed after %u to %u ms, file opened again (consistent runs of %u)\n", BENCH_CRASH_MIN_US / 1000,
+           BENCH_CRASH_MAX_US / 1000, BENCH_CRASH_RUNS);
+    for (mode = PARAMETERS_FILE_PWRITE; mode <= PARAMETERS_FILE_MMAP; mode++)
+    {
+        for (crash = BENCH_CRASH_IN_PLACE; crash < BENCH_CRASHES; crash++)
+        {
+            crash_runs[mode][crash] = bench_crash(mode, crash);
+        }
+        consistent[mode] = crash_runs[mode][BENCH_CRASH_JOURNAL] == BENCH_CRASH_RUNS &&
+                           crash_runs[mode][BENCH_CRASH_BANKS] == BENCH_CRASH_RUNS;
+    }
+    printf("%10s %10s %10s %10s\n", "file", bench_crash_name[0], bench_crash_name[1], bench_crash_name[2]);
+    for (mode = PARAMETERS_FILE_PWRITE; mode <= PARAMETERS_FILE_MMAP; mode++)
+    {
+        printf("%10s %10u %10u %10u%s\n", mode == PARAMETERS_FILE_MMAP ? "mmap" : "pwrite", crash_runs[mode][0],
+               crash_runs[mode][1], crash_runs[mode][2], consistent[mode] ? "" : "   FAILED");
+    }
+    return consistent[PARAMETERS_FILE_PWRITE] && consistent[PARAMETERS_FILE_MMAP];
+}
+
+/**
+ * @description:                                Print the stress runs without and with the seqlock
+ * @return      {*}                             false if a seqlock reader saw a torn value
+ * @note       :                                Unprotected readers are expected to see some
+ */
+static bool bench_stress_table(void)
+{
+    unsigned long writes, reads, torn;
+
+    printf("\n%u readers against one writer for %u ms\n", BENCH_STRESS_READERS, BENCH_STRESS_MS);
+    printf("%10s %12s %12s %12s\n", "readers", "writes", "reads", "torn");
+    writes = bench_stress(false, &reads, &torn);
+    printf("%10s %12lu %12lu %12lu\n", "unlocked", writes, reads, torn);
+    writes = bench_stress(true, &reads, &torn);
+    printf("%10s %12lu %12lu %12lu%s\n", "seqlock", writes, reads, torn, torn != 0 ? "   FAILED" : "");
+    return torn == 0;
+}
+
+/**
+ * @description:                                Change a few hot parameters from a control loop while ROM writes are slow
+ * @param       {bool} async                    ROM written by a write-behind thread or by the changing thread
+ * @param       {double} *avg_us                mean Parameters_Chanege call
+ * @param       {double} *worst_us              longest Parameters_Chanege call
+ * @param       {double} *flush_ms              time Parameters_Flush waited after the loop
+ * @param       {unsigned int} *writes          Write_2_ROM calls
+ * @return      {*}                             true if a table loaded from ROM after the flush matches RAM
+ * @note       :                                Some writes fail halfway through the loop
+ */
+static bool bench_async(bool async, double *avg_us, double *worst_us, double *flush_ms, unsigned int *writes)
+{
+    PARAMETERS_CONFIG_T config;
+    PARAMETERS_CB_T table, reload;
+    PARAMETERS_WORKER_T worker;
+    unsigned int size = (BENCH_ASYNC_PARAMS + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    unsigned char *RAM_reload = malloc(size);
+    unsigned int count, value;
+    double before, taken, total = 0;
+    char name[17];
+    bool status;
+
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.hash_size = Parameters_Hash_Slots(size);
+    config.hash_block = malloc(config.hash_size * sizeof(unsigned short));
+    if (async)
+    {
+        config.dirty_block = malloc(Parameters_Dirty_Size(size));
+        config.async_size = Parameters_Hash_Slots(size);
+        config.async_ring = malloc(config.async_size * sizeof(unsigned short));
+        config.seqlock = true;
+    }
+    simulation_ROM_size = size + 64;
+    simulation_ROM = calloc(1, simulation_ROM_size);
+    simulation_ROM_failures = 0;
+    simulation_ROM_delay_us = 0;
+
+    Parameters_Init_Ex(&table, "ASYNC", RAM, 0, size, Read_From_ROM, Write_2_ROM, checksum, &config);
+    for (count = 0; count < BENCH_ASYNC_PARAMS; count++)
+    {
+        value = 0;
+        snprintf(name, sizeof(name), "ASYNC_%03u", count);
+        Parameters_Creat(&table, name, PARAMETERS_TYPE_UINT32, &value);
+    }
+    Parameters_Flush(&table);
+    if (async)
+    {
+        Parameters_Worker_Start(&worker, &table, 8000);
+    }
+
+    simulation_ROM_delay_us = BENCH_ASYNC_WRITE_US;
+    simulation_ROM_writes = 0;
+    *worst_us = 0;
+    for (count = 0; count < BENCH_ASYNC_CHANGES; count++)
+    {
+        if (count == BENCH_ASYNC_CHANGES / 2)
+        {
+            simulation_ROM_failures = BENCH_ASYNC_FAILURES;
+        }
+        value = count;
+        snprintf(name, sizeof(name), "ASYNC_%03u", count % BENCH_ASYNC_HOT);
+        before = now_ns();
+        Parameters_Chanege(&table, name, PARAMETERS_TYPE_UINT32, &value);
+        taken = (now_ns() - before) / 1000;
+        total += taken;
+        *worst_us = taken > *worst_us ? taken : *worst_us;
+    }
+    *avg_us = total / BENCH_ASYNC_CHANGES;
+
+    before = now_ns();
+    status = Parameters_Flush(&table);
+    *flush_ms = (now_ns() - before) / 1e6;
+    *writes = simulation_ROM_writes;
+    if (async)
+    {
+        Parameters_Worker_Stop(&worker);
+    }
+
+    simulation_ROM_delay_us = 0;
+    simulation_ROM_failures = 0;
+    status &= Parameters_Init(&reload, "ASYNC", RAM_reload, 0, size, Read_From_ROM, Write_2_ROM, checksum) &&
+              memcmp(RAM, RAM_reload, size) == 0;
+
+    free(simulation_ROM);
+    free(config.async_ring);
+    free(config.dirty_block);
+    free(config.hash_block);
+    free(RAM_reload);
+    free(RAM);
+    return status;
+}
+
+typedef enum
+{
+    BENCH_CREATE = 0,
+    BENCH_LOOKUP,
+    BENCH_CHANGE,
+    BENCH_DELETE,
+    BENCH_INIT,
+    BENCH_IMPORT,
+    BENCH_OPERATIONS,
+} BENCH_OPERATION_T;
+
+static const char *const bench_operation_name[BENCH_OPERATIONS] = {"create", "lookup", "change", "delete", "init", "import"};
+
+typedef struct
+{
+    unsigned int ops;
+    unsigned int failed;     // calls returning false
+    unsigned long injected;  // Write_2_ROM calls failed by the flash
+    double ops_per_s;        // modelled time: wall clock plus the flash model
+    double p50_us, p99_us, max_us;
+    unsigned long rom_bytes; // bytes programmed, with the sectors rewritten around them
+    unsigned long erases;
+    double amplification;    // rom_bytes over the parameter bytes changed, 0 for read only operations
+    bool reload;             // the flash reloads with every parameter
+} BENCH_RESULT_T;
+
+static int bench_compare(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @description:                                Run one operation of a table on the simulated flash
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {BENCH_OPERATION_T} operation   operation to time
+ * @param       {unsigned int} fail_every       every n-th Write_2_ROM call fails, 0 for none
+ * @param       {BENCH_RESULT_T} *result        measures of the operation
+ * @return      {*}
+ * @note       :                                The flash has BENCH_SECTOR byte sectors rewritten through a
+ *                                              read-erase-program driver, only the timed calls see injected failures.
+ *                                              Deletes take BENCH_SUITE_DELETES parameters spread over the table
+ */
+static void bench_suite(unsigned int number, BENCH_OPERATION_T operation, unsigned int fail_every, BENCH_RESULT_T *result)
+{
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    unsigned int size = (number + 1) * 21 + 1;
+    unsigned char *RAM = malloc(size);
+    char(*names)[17] = malloc(number * 17);
+    unsigned int ops = operation == BENCH_LOOKUP   ? BENCH_SUITE_LOOKUPS
+                       : operation == BENCH_INIT   ? BENCH_SUITE_INITS
+                       : operation == BENCH_DELETE ? BENCH_SUITE_DELETES
+                                                   : number;
+    double *latency = malloc(ops * sizeof(double));
+    unsigned long logical = 0;
+    unsigned long long elapsed;
+    unsigned int count;
+    unsigned short index;
+    float value = 0.0f;
+    double start, total = 0.0;
+    bool status = true;
+
+    Sim_Flash_Open(((size + 64) / BENCH_SECTOR + 1) * BENCH_SECTOR, BENCH_SECTOR);
+    memset(&config, 0, sizeof(config));
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    config.hash_size = Parameters_Hash_Slots(size);
+    config.hash_block = malloc(config.hash_size * sizeof(unsigned short));
+    config.dirty_block = malloc(Parameters_Dirty_Size(size));
+
+    memset(&table, 0, sizeof(table));
+    Parameters_Init_Ex(&table, "SUITE", RAM, 0, size, Sim_Flash_Read, Sim_Flash_Write_Erasing, checksum, &config);
+    for (count = 0; count < number; count++)
+    {
+        bench_name(names[count], count);
+    }
+    if (operation != BENCH_CREATE && operation != BENCH_IMPORT)
+    {
+        Parameters_Begin(&table);
+        for (count = 0; count < number; count++)
+        {
+            Parameters_Creat(&table, names[count], PARAMETERS_TYPE_F32, &value);
+        }
+        Parameters_Commit(&table);
+    }
+
+    Sim_Flash_Reset_Counters();
+    sim_flash.call_latency_ns = BENCH_CALL_LATENCY_NS;
+    sim_flash.byte_cost_ns = BENCH_BYTE_COST_NS;
+    sim_flash.erase_cost_ns = BENCH_ERASE_COST_NS;
+    sim_flash.fail_every = fail_every;
+    memset(result, 0, sizeof(BENCH_RESULT_T));
+    if (operation == BENCH_IMPORT)
+    {
+        Parameters_Begin(&table);
+    }
+    for (count = 0; count < ops; count++)
+    {
+        elapsed = sim_flash.elapsed_ns;
+        start = now_ns();
+        switch (operation)
+        {
+        case BENCH_CREATE:
+        case BENCH_IMPORT:
+            status = Parameters_Creat(&table, names[count], PARAMETERS_TYPE_F32, &value);
+            logical += 21;
+            break;
+        case BENCH_LOOKUP:
+            status = Parameters_Get_by_name(&table, names[(count * 7919u) % number], &index, &value) != 0;
+            break;
+        case BENCH_CHANGE:
+            value = (float)count;
+            status = Parameters_Chanege(&table, names[count], PARAMETERS_TYPE_F32, &value);
+            logical += sizeof(float);
+            break;
+        case BENCH_DELETE:
+            status = Parameters_Del(&table, names[count * (number / BENCH_SUITE_DELETES)]);
+            logical += 21;
+            break;
+        default:
+            memset(&table, 0, sizeof(table));
+            status = Parameters_Init_Ex(&table, "SUITE", RAM, 0, size, Sim_Flash_Read, Sim_Flash_Write_Erasing,
+                                        checksum, &config) &&
+                     table.table_info.used_number == number;
+            break;
+        }
+        if (operation == BENCH_IMPORT && count + 1 == ops)
+        {
+            status &= Parameters_Commit(&table);
+        }
+        latency[count] = now_ns() - start + (sim_flash.elapsed_ns - elapsed);
+        total += latency[count];
+        result->failed += !status;
+    }
+
+    result->ops = ops;
+    result->rom_bytes = sim_flash.write_bytes;
+    result->erases = sim_flash.erase_calls;
+    result->injected = sim_flash.failed_calls;
+    result->amplification = logical != 0 ? (double)sim_flash.write_bytes / logical : 0.0;
+    result->ops_per_s = ops / (total / 1e9);
+    qsort(latency, ops, sizeof(double), bench_compare);
+    result->p50_us = latency[ops / 2] / 1000.0;
+    result->p99_us = latency[ops * 99 / 100] / 1000.0;
+    result->max_us = latency[ops - 1] / 1000.0;
+
+    sim_flash.fail_every = 0;
+    count = table.table_info.used_number;
+    memset(&table, 0, sizeof(table));
+    result->reload = Parameters_Init_Ex(&table, "SUITE", RAM, 0, size, Sim_Flash_Read, Sim_Flash_Write_Erasing,
+                                        checksum, &config) &&
+                     table.table_info.used_number == count;
+
+    Sim_Flash_Close();
+    free(config.dirty_block);
+    free(config.hash_block);
+    free(latency);
+    free(names);
+    free(RAM);
+}
+
+#if PARAMETERS_STATS
+/**
+ * @description:                                Counters of a boot followed by a lookup of every parameter
+ * @param       {unsigned int} number           number of parameters in the table
+ * @param       {bool} hashed                   search through the hash index or linearly
+ * @param       {PARAMETERS_STATS_T} *stats     counters of the table
+ * @return      {*}
+ * @note       :
+ */
+static void bench_stats(unsigned int number, bool hashed, PARAMETERS_STATS_T *stats)
+{
+    BENCH_TABLE_T bench;
+    PARAMETERS_CONFIG_T config;
+    unsigned int count;
+    unsigned short index;
+    float value;
+
+    memset(&config, 0, sizeof(config));
+    config.hash_size = hashed;
+    config.check_mode = PARAMETERS_CHECK_INCREMENTAL;
+    bench_open(&bench, number, &config);
+
+    memset(&bench.table, 0, sizeof(bench.table));
+    Parameters_Init_Ex(&bench.table, "BENCH", bench.RAM, 0, bench.size, Read_From_ROM, Write_2_ROM, checksum, &bench.config);
+    for (count = 0; count < number; count++)
+    {
+        Parameters_Get_by_name(&bench.table, bench.names[count], &index, &value);
+    }
+    Parameters_Get_Stats(&bench.table, stats);
+
+    bench_close(&bench);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    static const unsigned int sizes[] = {64, 512, 4096};
+    static const unsigned int packed_sizes[] = {64, 512, 2048}; // a packed table is limited to 64 KiB
+    static const unsigned int registry_sizes[] = {4, 16, 64};
+    static const unsigned int checkout_sizes[] = {21, 256, 4096, 65536};
+    unsigned int count, writes, batched, saved, min, max;
+    unsigned long total, calls;
+    double before, after, stress_ms, read_ns;
+    double linear_ns, sorted_ns;
+    double tomb_before, tomb_after;
+    unsigned int mavlink_wrong[4];
+    BENCH_OPERATION_T operation;
+    BENCH_RESULT_T result;
+    BENCH_LOAD_T load;
+    BENCH_CHECKOUT_T checkout;
+    PARAMETERS_FILE_MODE_T mode;
+    double verify_us[3][BENCH_CHECKOUTS];
+    bool verify_detected[3][BENCH_CHECKOUTS];
+    unsigned int load_writes[BENCH_LOADS];
+    unsigned long load_bytes[BENCH_LOADS];
+    const char *load_reload[BENCH_LOADS], *reload;
+#if PARAMETERS_STATS
+    PARAMETERS_STATS_T stats;
+    unsigned int hashed;
+#endif
+    bool status;
+    bool failed = false;
+
+    // a single check, as ctest runs it
+    if (argc > 1 && strcmp(argv[1], "stress") == 0)
+    {
+        return bench_stress_table() ? 0 : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "crash") == 0)
+    {
+        return bench_crash_table() ? 0 : 1;
+    }
+
+    printf("simulated flash, %u byte sectors, %u ns per call, %u ns per byte, %u us per erase\n", BENCH_SECTOR,
+           BENCH_CALL_LATENCY_NS, BENCH_BYTE_COST_NS, BENCH_ERASE_COST_NS / 1000);
+    printf("%8s %8s %12s %10s %10s %10s %12s %8s %8s %8s\n", "op", "params", "ops/s", "p50 us", "p99 us", "max us",
+           "ROM bytes", "erases", "amp", "failed");
+    for (operation = BENCH_CREATE; operation < BENCH_OPERATIONS; operation++)
+    {
+        for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+        {
+            bench_suite(sizes[count], operation, 0, &result);
+            printf("%8s %8u %12.1f %10.1f %10.1f %10.1f %12lu %8lu %8.1f %8u\n", bench_operation_name[operation],
+                   sizes[count], result.ops_per_s, result.p50_us, result.p99_us, result.max_us, result.rom_bytes,
+                   result.erases, result.amplification, result.failed);
+        }
+    }
+
+    printf("\nchange with 1 in %u Write_2_ROM calls failing\n", BENCH_FAIL_EVERY);
+    printf("%8s %12s %10s %10s %10s %8s %8s\n", "params", "ops/s", "p50 us", "p99 us", "injected", "failed", "reload");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        bench_suite(sizes[count], BENCH_CHANGE, BENCH_FAIL_EVERY, &result);
+        printf("%8u %12.1f %10.1f %10.1f %10lu %8u %8s\n", sizes[count], result.ops_per_s, result.p50_us, result.p99_us,
+               result.injected, result.failed, result.reload ? "ok" : "FAILED");
+    }
+
+#if PARAMETERS_STATS
+    printf("\ncounters of a boot and a lookup of every parameter\n");
+    printf("%8s %8s %10s %10s %10s %10s %12s\n", "params", "search", "lookups", "avg probe", "max probe", "ROM reads",
+           "hashed bytes");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        for (hashed = 0; hashed < 2; hashed++)
+        {
+            bench_stats(sizes[count], hashed, &stats);
+            printf("%8u %8s %10lu %10.1f %10u %10lu %12lu\n", sizes[count], hashed ? "hashed" : "linear",
+                   stats.lookups, (double)stats.probes / stats.lookups, stats.max_probe, stats.read_calls,
+                   stats.hashed_bytes);
+        }
+    }
+#endif
+
+    printf("\nlookup by name (ns/op)\n");
+    printf("%8s %12s %12s %10s\n", "params", "linear", "hashed", "speedup");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_lookup(sizes[count], false);
+        after = bench_lookup(sizes[count], true);
+        printf("%8u %12.1f %12.1f %9.1fx\n", sizes[count], before, after, before / after);
+    }
+
+    printf("\nlinear search (M identifiers compared / s)\n");
+    printf("%8s %12s %12s %10s\n", "params", "cells", "name block", "speedup");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_scan(sizes[count], false);
+        after = bench_scan(sizes[count], true);
+        printf("%8u %12.1f %12.1f %9.1fx\n", sizes[count], before, after, after / before);
+    }
+
+    printf("\nparameters under the prefix %s, 10 at every size (ns/query, lookup by name ns/op)\n", BENCH_PREFIX);
+    printf("%8s %12s %12s %10s %12s %12s %10s\n", "params", "by index", "sorted", "speedup", "linear", "sorted",
+           "speedup");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_prefix(sizes[count], false, &linear_ns);
+        after = bench_prefix(sizes[count], true, &sorted_ns);
+        printf("%8u %12.1f %12.1f %9.1fx %12.1f %12.1f %9.1fx\n", sizes[count], before, after, before / after, linear_ns,
+               sorted_ns, linear_ns / sorted_ns);
+    }
+
+    printf("\nRAM per parameter (bytes / lookup by name ns)\n");
+    printf("%8s %20s %20s %20s\n", "params", "linear", "hashed", "lean");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_lookup(sizes[count], false);
+        after = bench_lookup(sizes[count], true);
+        read_ns = bench_lean(sizes[count], &writes);
+        total = (sizes[count] + 1) * 21 + 1; // RAM block of bench_open
+        printf("%8u %8.1f / %9.1f %8.1f / %9.1f %8.1f / %9.1f\n", sizes[count], (double)total / sizes[count], before,
+               (double)(total + Parameters_Hash_Slots(total) * sizeof(unsigned short)) / sizes[count], after,
+               (double)writes / sizes[count], read_ns);
+    }
+
+    printf("\npoll one parameter for changes (ns/op)\n");
+    printf("%8s %12s %12s %12s\n", "params", "by name", "version", "subscribed");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        printf("%8u %12.1f %12.1f %12.1f\n", sizes[count], bench_poll(sizes[count], 0), bench_poll(sizes[count], 1),
+               bench_poll(sizes[count], 2));
+    }
+
+    printf("\nmirror a table, %u changes between syncs (ns / parameters sent per sync)\n", BENCH_MIRROR_CHANGES);
+    printf("%8s %20s %20s\n", "params", "whole table", "changes");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_mirror(sizes[count], false, &calls);
+        printf("%8u %12.0f / %5lu", sizes[count], before, calls);
+        after = bench_mirror(sizes[count], true, &calls);
+        printf(" %12.0f / %5lu\n", after, calls);
+    }
+
+    printf("\nanswer PARAM_REQUEST_LIST, %u byte TX buffers (PARAM_VALUE payloads per second)\n", BENCH_MAVLINK_BUDGET);
+    printf("%8s %14s %14s %14s %14s %8s\n", "params", "by hand", "stream", "by hand tomb", "stream tomb", "wrong");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_mavlink(sizes[count], false, false, &mavlink_wrong[0]);
+        after = bench_mavlink(sizes[count], true, false, &mavlink_wrong[1]);
+        tomb_before = bench_mavlink(sizes[count], false, true, &mavlink_wrong[2]);
+        tomb_after = bench_mavlink(sizes[count], true, true, &mavlink_wrong[3]);
+        printf("%8u %14.0f %14.0f %14.0f %14.0f %8u\n", sizes[count], before, after, tomb_before, tomb_after,
+               mavlink_wrong[0] + mavlink_wrong[1] + mavlink_wrong[2] + mavlink_wrong[3]);
+    }
+
+    printf("\n%u parameters declared at build time (us per registration / ns per read)\n", BENCH_COUNT);
+    printf("%10s %20s %20s\n", "boot", "by name", "declared");
+    for (count = 0; count < 2; count++)
+    {
+        before = bench_declared(false, count != 0, &read_ns);
+        printf("%10s %12.1f / %5.1f", count != 0 ? "existing" : "first", before, read_ns);
+        after = bench_declared(true, count != 0, &read_ns);
+        printf(" %12.1f / %5.1f\n", after, read_ns);
+    }
+
+    printf("\nfind a parameter among tables of %u parameters (ns/op), grow one table (ROM bytes)\n", BENCH_REGISTRY_PARAMS);
+    printf("%8s %12s %12s %10s %12s %12s %8s\n", "tables", "each table", "registry", "speedup", "move", "reflash",
+           "status");
+    for (count = 0; count < sizeof(registry_sizes) / sizeof(registry_sizes[0]); count++)
+    {
+        status = bench_registry(registry_sizes[count], false, &before, &calls, &total);
+        status = bench_registry(registry_sizes[count], true, &after, &calls, &total) && status;
+        printf("%8u %12.1f %12.1f %9.1fx %12lu %12lu %8s\n", registry_sizes[count], before, after, before / after, calls,
+               total, status ? "ok" : "FAILED");
+    }
+
+    printf("\nwrite by handle (ns/op)\n");
+    printf("%8s %12s %12s %10s\n", "params", "whole", "incremental", "speedup");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_write(sizes[count], PARAMETERS_CHECK_WHOLE);
+        after = bench_write(sizes[count], PARAMETERS_CHECK_INCREMENTAL);
+        printf("%8u %12.1f %12.1f %9.1fx\n", sizes[count], before, after, before / after);
+    }
+
+    printf("\ncheckout throughput, %u bit check values (M bytes / s)\n", (unsigned int)sizeof(PARAMETERS_CHECK_T) * 8);
+    printf("%8s", "bytes");
+    for (checkout = BENCH_CHECKOUT_SUM; checkout < BENCH_CHECKOUTS; checkout++)
+    {
+        printf(" %12s", bench_checkout_name[checkout]);
+    }
+    printf("\n");
+    for (count = 0; count < sizeof(checkout_sizes) / sizeof(checkout_sizes[0]); count++)
+    {
+        printf("%8u", checkout_sizes[count]);
+        for (checkout = BENCH_CHECKOUT_SUM; checkout < BENCH_CHECKOUTS; checkout++)
+        {
+            printf(" %12.1f", bench_checkout(checkout_sizes[count], checkout));
+        }
+        printf("\n");
+    }
+
+    printf("\nParameters_Init of a table checked as a whole (us / two bytes swapped, CRC32C on %s)\n",
+           Parameters_CRC32C_Hardware() ? "CRC instructions" : "the table");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        for (checkout = BENCH_CHECKOUT_SUM; checkout < BENCH_CHECKOUTS; checkout++)
+        {
+            verify_us[count][checkout] = bench_verify(sizes[count], checkout, &verify_detected[count][checkout]);
+        }
+    }
+    printf("%8s", "params");
+    for (checkout = BENCH_CHECKOUT_SUM; checkout < BENCH_CHECKOUTS; checkout++)
+    {
+        printf(" %20s", bench_checkout_name[checkout]);
+    }
+    printf("\n");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        printf("%8u", sizes[count]);
+        for (checkout = BENCH_CHECKOUT_SUM; checkout < BENCH_CHECKOUTS; checkout++)
+        {
+            printf(" %9.1f / %8s", verify_us[count][checkout], verify_detected[count][checkout] ? "detected" : "missed");
+        }
+        printf("\n");
+    }
+
+    printf("\npush every parameter (Write_2_ROM calls)\n");
+    printf("%8s %12s %12s %10s\n", "params", "immediate", "batched", "saved");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        writes = bench_push(sizes[count], false, &saved);
+        batched = bench_push(sizes[count], true, &saved);
+        printf("%8u %12u %12u %10u\n", sizes[count], writes, batched, saved);
+    }
+
+    printf("\nload a new value into every parameter (Write_2_ROM calls / bytes, boot after the last write is cut)\n");
+    printf("%8s", "params");
+    for (load = BENCH_LOAD_CHANGE; load < BENCH_LOADS; load++)
+    {
+        printf(" %20s %6s", bench_load_name[load], "cut");
+    }
+    printf(" %10s\n", "snapshot");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        for (load = BENCH_LOAD_CHANGE; load < BENCH_LOADS; load++)
+        {
+            load_writes[load] = bench_load(sizes[count], load, 0, &load_bytes[load], &saved, &reload);
+            bench_load(sizes[count], load, load_writes[load] - 1, &calls, &saved, &load_reload[load]);
+        }
+        printf("%8u", sizes[count]);
+        for (load = BENCH_LOAD_CHANGE; load < BENCH_LOADS; load++)
+        {
+            printf(" %9u / %8lu %6s", load_writes[load], load_bytes[load], load_reload[load]);
+        }
+        printf(" %10u\n", saved);
+    }
+
+    printf("\ndelete the first parameter (Write_2_ROM calls)\n");
+    printf("%8s %12s %12s\n", "params", "shift", "tombstone");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        printf("%8u %12u %12u\n", sizes[count], bench_delete(sizes[count], false), bench_delete(sizes[count], true));
+    }
+
+    printf("\nstartup, %u ns per call and %u ns per byte (us / Read_From_ROM calls)\n", BENCH_CALL_LATENCY_NS, BENCH_BYTE_COST_NS);
+    printf("%8s %20s %20s %20s\n", "params", "per cell", "256 byte chunks", "one read");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        printf("%8u", sizes[count]);
+        before = bench_startup(sizes[count], 21, &calls);
+        printf(" %12.0f / %5lu", before, calls);
+        before = bench_startup(sizes[count], 256, &calls);
+        printf(" %12.0f / %5lu", before, calls);
+        before = bench_startup(sizes[count], 0, &calls);
+        printf(" %12.0f / %5lu\n", before, calls);
+    }
+
+    printf("\nmostly 8 and 16 bit parameters (ROM bytes / hashed lookup ns)\n");
+    printf("%8s %20s %20s\n", "params", "fixed cells", "packed cells");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        before = bench_packed(packed_sizes[count], false, &writes);
+        printf("%8u %12u / %5.1f", packed_sizes[count], writes, before);
+        after = bench_packed(packed_sizes[count], true, &writes);
+        printf(" %12u / %5.1f\n", writes, after);
+    }
+
+    printf("\ntime to first parameter, pages of %u cells (us / Read_From_ROM calls)\n", BENCH_LAZY_PAGE);
+    printf("%8s %20s %20s %20s\n", "params", "full load", "lazy first", "lazy whole table");
+    for (count = 0; count < sizeof(sizes) / sizeof(sizes[0]); count++)
+    {
+        printf("%8u", sizes[count]);
+        before = bench_first(sizes[count], 0, false, &calls);
+        printf(" %12.0f / %5lu", before, calls);
+        before = bench_first(sizes[count], BENCH_LAZY_PAGE, false, &calls);
+        printf(" %12.0f / %5lu", before, calls);
+        before = bench_first(sizes[count], BENCH_LAZY_PAGE, true, &calls);
+        printf(" %12.0f / %5lu\n", before, calls);
+    }
+
+    failed |= !bench_stress_table();
+
+    printf("\n%u changes of %u parameters, %u us per Write_2_ROM, %u failed writes\n",
+           BENCH_ASYNC_CHANGES, BENCH_ASYNC_HOT, BENCH_ASYNC_WRITE_US, BENCH_ASYNC_FAILURES);
+    printf("%10s %12s %12s %12s %8s %8s\n", "storage", "avg us", "worst us", "flush ms", "writes", "reload");
+    status = bench_async(false, &before, &after, &stress_ms, &writes);
+    printf("%10s %12.1f %12.1f %12.1f %8u %8s\n", "sync", before, after, stress_ms, writes, status ? "ok" : "FAILED");
+    status = bench_async(true, &before, &after, &stress_ms, &writes);
+    printf("%10s %12.1f %12.1f %12.1f %8u %8s\n", "async", before, after, stress_ms, writes, status ? "ok" : "FAILED");
+
+    printf("\nerase cycles per sector, %u changes of one parameter over %u sectors\n", BENCH_WEAR_WRITES, BENCH_WEAR_SECTORS);
+    printf("%10s %8s %8s %8s %8s\n", "storage", "min", "max", "total", "reload");
+    status = bench_wear(false, &min, &max, &total);
+    printf("%10s %8u %8u %8lu %8s\n", "in-place", min, max, total, status ? "ok" : "FAILED");
+    status = bench_wear(true, &min, &max, &total);
+    printf("%10s %8u %8u %8lu %8s\n", "journal", min, max, total, status ? "ok" : "FAILED");
+
+    printf("\n%u changes of %u parameters kept in %s, until durable (changes/s / syncs)\n", BENCH_FILE_CHANGES,
+           BENCH_FILE_PARAMS, BENCH_FILE_PATH);
+    printf("%10s %20s %20s\n", "file", "sync every write", "2 ms window");
+    for (mode = PARAMETERS_FILE_PWRITE; mode <= PARAMETERS_FILE_MMAP; mode++)
+    {
+        before = bench_file(mode, 0, &calls);
+        after = bench_file(mode, BENCH_FILE_WINDOW_US, &total);
+        printf("%10s %12.0f / %5lu %12.0f / %5lu\n", mode == PARAMETERS_FILE_MMAP ? "mmap" : "pwrite", before, calls,
+               after, total);
+    }
+
+    failed |= !bench_crash_table();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * @Description    : Parameters C++ access benchmark
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 18:02:37
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 18:02:37
+ * @FilePath       : \Parameters\bench\parameters_bench_cpp.cpp
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Parameters.hpp"
+
+#define BENCH_READS 2000000
+#define BENCH_WRITES 5000
+#define BENCH_PARAMS 64
+
+using namespace parameters;
+
+static unsigned char *simulation_ROM;
+
+static PARAMETERS_CHECK_T checksum(unsigned char *data, unsigned int size)
+{
+    PARAMETERS_CHECK_T sum = 0;
+
+    while (size--)
+    {
+        sum += *data++;
+    }
+    return sum;
+}
+
+static bool Read_From_ROM(unsigned char *dst, unsigned int offset, unsigned int size)
+{
+    memcpy(dst, simulation_ROM + offset, size);
+    return true;
+}
+
+static bool Write_2_ROM(unsigned char *src, unsigned int offset, unsigned int size)
+{
+    memcpy(simulation_ROM + offset, src, size);
+    return true;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef enum
+{
+    BENCH_RAW,
+    BENCH_PARAM,
+    BENCH_HANDLE,
+    BENCH_NAME,
+} BENCH_ACCESS_T;
+
+/**
+ * @description:                                Time reading one float parameter of a hashed table
+ * @param       {PARAMETERS_CB_T} *table        table holding the parameter
+ * @param       {BENCH_ACCESS_T} access         raw pointer, Param<float>, handle or identifier
+ * @return      {*}                             average nanoseconds per read
+ * @note       :
+ */
+static double bench_read(PARAMETERS_CB_T *table, BENCH_ACCESS_T access)
+{
+    Param<float> param(table, "GAIN_P", 0.0f);
+    PARAMETERS_HANDLE_T handle;
+    volatile float *raw = (volatile float *)Parameters_Handle_Data(table, param.handle());
+    volatile float sink = 0.0f;
+    unsigned short index;
+    unsigned int count;
+    float value = 0.0f;
+    double start;
+
+    Parameters_Get_Handle(table, (char *)"GAIN_P", &handle);
+
+    start = now_ns();
+    for (count = 0; count < BENCH_READS; count++)
+    {
+        switch (access)
+        {
+        case BENCH_RAW:
+            value = *raw;
+            break;
+        case BENCH_PARAM:
+            value = param;
+            break;
+        case BENCH_HANDLE:
+            Parameters_Get_by_handle(table, handle, PARAMETERS_TYPE_F32, &value);
+            break;
+        case BENCH_NAME:
+            Parameters_Get_by_name(table, (char *)"GAIN_P", &index, &value);
+            break;
+        }
+        sink = sink + value;
+    }
+    return (now_ns() - start) / BENCH_READS;
+}
+
+/**
+ * @description:                                Time changing one float parameter of a hashed table
+ * @param       {PARAMETERS_CB_T} *table        table holding the parameter
+ * @param       {bool} wrapped                  Param<float> or Parameters_Chanege
+ * @return      {*}                             average nanoseconds per write
+ * @note       :
+ */
+static double bench_change(PARAMETERS_CB_T *table, bool wrapped)
+{
+    Param<float> param(table, "GAIN_P", 0.0f);
+    unsigned int count;
+    float value;
+    double start;
+
+    start = now_ns();
+    for (count = 0; count < BENCH_WRITES; count++)
+    {
+        value = (float)count;
+        if (wrapped)
+        {
+            param = value;
+        }
+        else
+        {
+            Parameters_Chanege(table, (char *)"GAIN_P", PARAMETERS_TYPE_F32, &value);
+        }
+    }
+    return (now_ns() - start) / BENCH_WRITES;
+}
+
+int main(void)
+{
+    static const char *const access_name[] = {"raw pointer", "Param<float>", "Get_by_handle", "Get_by_name"};
+    PARAMETERS_CB_T table;
+    PARAMETERS_CONFIG_T config;
+    unsigned int size = (BENCH_PARAMS + 1) * 21 + 1;
+    unsigned char *RAM = (unsigned char *)malloc(size);
+    char name[17];
+    unsigned int count;
+    int access;
+    float value = 0.0f;
+
+    memset(&table, 0, sizeof(table));
+    memset(&config, 0, sizeof(config));
+    config.hash_size = Parameters_Hash_Slots(size);
+    config.hash_block = (unsigned short *)malloc(config.hash_size * sizeof(unsigned short));
+    simulation_ROM = (unsigned char *)calloc(1, size + 64);
+
+    Parameters_Init_Ex(&table, (char *)"BENCH", RAM, 0, size, Read_From_ROM, Write_2_ROM, checksum, &config);
+    for (count = 0; count < BENCH_PARAMS - 1; count++)
+    {
+        snprintf(name, sizeof(name), "PARAM_%05u", count);
+        Parameters_Creat(&table, name, PARAMETERS_TYPE_F32, &value);
+    }
+
+    printf("Read of one float parameter, %u parameters, hashed:\n", BENCH_PARAMS);
+    for (access = BENCH_RAW; access <= BENCH_NAME; access++)
+    {
+        printf("%16s %8.2f ns/read\n", access_name[access], bench_read(&table, (BENCH_ACCESS_T)access));
+    }
+
+    printf("Change of one float parameter:\n");
+    printf("%16s %8.2f ns/write\n", "Param<float>", bench_change(&table, true));
+    printf("%16s %8.2f ns/write\n", "Chanege", bench_change(&table, false));
+
+    free(simulation_ROM);
+    free(config.hash_block);
+    free(RAM);
+    return 0;
+}
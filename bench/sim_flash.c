@@ -0,0 +1,207 @@
+/*
+ * @Description    : Simulated flash for benchmarks
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 10:05:12
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 10:05:12
+ * @FilePath       : \Parameters\bench\sim_flash.c
+ */
+
+#include "sim_flash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_FLASH_ERASED 0xFF
+
+SIM_FLASH_T sim_flash;
+
+/**
+ * @description:                                Create an erased flash device
+ * @param       {unsigned int} size             bytes of the device
+ * @param       {unsigned int} sector_size      erase granularity in bytes
+ * @return      {*}
+ * @note       :
+ */
+void Sim_Flash_Open(unsigned int size, unsigned int sector_size)
+{
+    memset(&sim_flash, 0, sizeof(sim_flash));
+    sim_flash.size = size;
+    sim_flash.sector_size = sector_size;
+    sim_flash.data = malloc(size);
+    sim_flash.erase_count = calloc((size + sector_size - 1) / sector_size, sizeof(unsigned int));
+    memset(sim_flash.data, SIM_FLASH_ERASED, size);
+}
+
+void Sim_Flash_Close(void)
+{
+    free(sim_flash.data);
+    free(sim_flash.erase_count);
+    memset(&sim_flash, 0, sizeof(sim_flash));
+}
+
+void Sim_Flash_Reset_Counters(void)
+{
+    sim_flash.read_calls = 0;
+    sim_flash.read_bytes = 0;
+    sim_flash.write_calls = 0;
+    sim_flash.write_bytes = 0;
+    sim_flash.erase_calls = 0;
+    sim_flash.failed_calls = 0;
+    sim_flash.elapsed_ns = 0;
+    sim_flash.fail_tick = 0;
+    memset(sim_flash.erase_count, 0, ((sim_flash.size + sim_flash.sector_size - 1) / sim_flash.sector_size) * sizeof(unsigned int));
+}
+
+/**
+ * @description:                                Spread of erase cycles over the sectors
+ * @param       {unsigned int} *min             fewest erases of a sector
+ * @param       {unsigned int} *max             most erases of a sector
+ * @param       {unsigned long} *total          erases of the device
+ * @return      {*}
+ * @note       :
+ */
+void Sim_Flash_Wear(unsigned int *min, unsigned int *max, unsigned long *total)
+{
+    unsigned int sectors = (sim_flash.size + sim_flash.sector_size - 1) / sim_flash.sector_size;
+    unsigned int count;
+
+    *min = 0xFFFFFFFF;
+    *max = 0;
+    *total = 0;
+    for (count = 0; count < sectors; count++)
+    {
+        *min = sim_flash.erase_count[count] < *min ? sim_flash.erase_count[count] : *min;
+        *max = sim_flash.erase_count[count] > *max ? sim_flash.erase_count[count] : *max;
+        *total += sim_flash.erase_count[count];
+    }
+}
+
+bool Sim_Flash_Read(unsigned char *dst, unsigned int offset, unsigned int size)
+{
+    if (offset + size > sim_flash.size)
+    {
+        return false;
+    }
+    memcpy(dst, sim_flash.data + offset, size);
+    sim_flash.read_calls++;
+    sim_flash.read_bytes += size;
+    sim_flash.elapsed_ns += sim_flash.call_latency_ns + size * sim_flash.byte_cost_ns;
+    return true;
+}
+
+/**
+ * @description:                                Decide if a write call fails by injection
+ * @return      {*}                             the call fails
+ * @note       :                                A failed call still costs its latency
+ */
+static bool Sim_Flash_Fault(void)
+{
+    sim_flash.fail_tick++;
+    if (sim_flash.fail_next == 0 && (sim_flash.fail_every == 0 || sim_flash.fail_tick % sim_flash.fail_every != 0))
+    {
+        return false;
+    }
+    sim_flash.fail_next -= sim_flash.fail_next != 0;
+    sim_flash.failed_calls++;
+    sim_flash.elapsed_ns += sim_flash.call_latency_ns;
+    return true;
+}
+
+/**
+ * @description:                                Program bytes, as NOR flash only 1 bits can become 0
+ * @param       {unsigned char} *src
+ * @param       {unsigned int} offset
+ * @param       {unsigned int} size
+ * @return      {*}                             fails if a byte needs an erase first
+ * @note       :
+ */
+static bool Sim_Flash_Program(unsigned char *src, unsigned int offset, unsigned int size)
+{
+    unsigned int count;
+
+    if (offset + size > sim_flash.size)
+    {
+        return false;
+    }
+    for (count = 0; count < size; count++)
+    {
+        if ((sim_flash.data[offset + count] & src[count]) != src[count])
+        {
+            return false;
+        }
+    }
+    for (count = 0; count < size; count++)
+    {
+        sim_flash.data[offset + count] &= src[count];
+    }
+    sim_flash.write_calls++;
+    sim_flash.write_bytes += size;
+    sim_flash.elapsed_ns += sim_flash.call_latency_ns + size * sim_flash.byte_cost_ns;
+    return true;
+}
+
+bool Sim_Flash_Write(unsigned char *src, unsigned int offset, unsigned int size)
+{
+    return !Sim_Flash_Fault() && Sim_Flash_Program(src, offset, size);
+}
+
+bool Sim_Flash_Erase(unsigned int offset, unsigned int size)
+{
+    unsigned int sector;
+
+    if (offset % sim_flash.sector_size != 0 || size % sim_flash.sector_size != 0 || offset + size > sim_flash.size)
+    {
+        return false;
+    }
+    memset(sim_flash.data + offset, SIM_FLASH_ERASED, size);
+    for (sector = offset / sim_flash.sector_size; sector < (offset + size) / sim_flash.sector_size; sector++)
+    {
+        sim_flash.erase_count[sector]++;
+    }
+    sim_flash.erase_calls++;
+    sim_flash.elapsed_ns += sim_flash.call_latency_ns + size / sim_flash.sector_size * sim_flash.erase_cost_ns;
+    return true;
+}
+
+/**
+ * @description:                                Rewrite bytes in place the way a flash driver does for the in-place layout
+ * @param       {unsigned char} *src
+ * @param       {unsigned int} offset
+ * @param       {unsigned int} size
+ * @return      {*}
+ * @note       :                                Each touched sector that cannot be programmed directly is read,
+ *                                              erased and programmed back with the new bytes
+ */
+bool Sim_Flash_Write_Erasing(unsigned char *src, unsigned int offset, unsigned int size)
+{
+    unsigned char *sector_copy;
+    unsigned int start, end, sector_start;
+
+    if (offset + size > sim_flash.size || Sim_Flash_Fault())
+    {
+        return false;
+    }
+    if (Sim_Flash_Program(src, offset, size))
+    {
+        return true;
+    }
+
+    sector_copy = malloc(sim_flash.sector_size);
+    start = offset;
+    end = offset + size;
+    while (start < end)
+    {
+        sector_start = start - start % sim_flash.sector_size;
+        memcpy(sector_copy, sim_flash.data + sector_start, sim_flash.sector_size);
+        while (start < end && start < sector_start + sim_flash.sector_size)
+        {
+            sector_copy[start - sector_start] = src[start - offset];
+            start++;
+        }
+        Sim_Flash_Erase(sector_start, sim_flash.sector_size);
+        Sim_Flash_Program(sector_copy, sector_start, sim_flash.sector_size);
+    }
+    free(sector_copy);
+    return true;
+}
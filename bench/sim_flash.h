@@ -0,0 +1,53 @@
+/*
+ * @Description    : Simulated flash for benchmarks
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 10:05:12
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 10:05:12
+ * @FilePath       : \Parameters\bench\sim_flash.h
+ */
+
+#ifndef _SIM_FLASH_H
+#define _SIM_FLASH_H
+
+#include <stdbool.h>
+
+typedef struct
+{
+    unsigned char *data;
+    unsigned int size;
+    unsigned int sector_size;
+
+    unsigned int *erase_count; // per sector
+    unsigned long read_calls;
+    unsigned long read_bytes;
+    unsigned long write_calls;
+    unsigned long write_bytes;
+    unsigned long erase_calls;
+    unsigned long failed_calls;
+
+    // timing model, accumulated in elapsed_ns without sleeping
+    unsigned long call_latency_ns;
+    unsigned long byte_cost_ns;
+    unsigned long erase_cost_ns; // per sector
+    unsigned long long elapsed_ns;
+
+    // injected failures of Sim_Flash_Write and Sim_Flash_Write_Erasing, nothing is programmed
+    unsigned int fail_next;  // next calls to fail
+    unsigned int fail_every; // every n-th call fails, 0 for none
+    unsigned long fail_tick;
+} SIM_FLASH_T;
+
+extern SIM_FLASH_T sim_flash;
+
+void Sim_Flash_Open(unsigned int size, unsigned int sector_size);
+void Sim_Flash_Close(void);
+void Sim_Flash_Reset_Counters(void);
+void Sim_Flash_Wear(unsigned int *min, unsigned int *max, unsigned long *total);
+
+bool Sim_Flash_Read(unsigned char *dst, unsigned int offset, unsigned int size);
+bool Sim_Flash_Write(unsigned char *src, unsigned int offset, unsigned int size);
+bool Sim_Flash_Write_Erasing(unsigned char *src, unsigned int offset, unsigned int size);
+bool Sim_Flash_Erase(unsigned int offset, unsigned int size);
+
+#endif //_SIM_FLASH_H
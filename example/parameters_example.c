@@ -11,23 +11,12 @@
 #include <string.h>
 
 #include "Parameters.h"
+#include "Parameters_checksum.h"
 
 PARAMETERS_CB_T parameters_test;
 unsigned char simulation_ROM[128];
 unsigned char simulation_RAM[128];
 
-unsigned short checksum(unsigned char *data, unsigned int size)
-{
-    unsigned short Sum;
-    while (size)
-    {
-        Sum += *data;
-        data++;
-        size--;
-    }
-    return Sum;
-}
-
 bool Read_From_ROM(unsigned char *dst, unsigned int offset, unsigned int size)
 {
     memcpy(dst, simulation_ROM + offset, size);
@@ -48,7 +37,7 @@ int main(void)
     memset(simulation_RAM, EMPTY_BYTE, sizeof(simulation_RAM));
 
     Parameters_Init(&parameters_test, "TEST\0", simulation_RAM, 0, 1024,
-                    Read_From_ROM, Write_2_ROM, checksum);
+                    Read_From_ROM, Write_2_ROM, Parameters_Checkout_CRC32C);
 
     float value_1 = 1024.0f;
     Parameters_Creat(&parameters_test, "ABCDEF\0", PARAMETERS_TYPE_F32, &value_1);
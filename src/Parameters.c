@@ -12,6 +12,18 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <stddef.h>
+
+// 128 bit compare of the identifiers of the name block, 0 for the portable one
+#ifndef PARAMETERS_SIMD
+#define PARAMETERS_SIMD 1
+#endif
+
+#if PARAMETERS_SIMD && defined(__SSE2__)
+#include <emmintrin.h>
+#elif PARAMETERS_SIMD && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #pragma pack(1)
 typedef struct
@@ -20,65 +32,305 @@ typedef struct
     unsigned char type;
     unsigned char data[4];
 } PARAMETERS_CELL_T;
+
+// a cell with room for the widest value, only the packed format stores it
+typedef struct
+{
+    char name[16];
+    unsigned char type;
+    unsigned char data[8];
+} PARAMETERS_WIDE_CELL_T;
+
+// journal storage, see Parameters_Journal_Load
+typedef struct
+{
+    char table_tag[16];
+    unsigned int sequence;
+    PARAMETERS_CHECK_T check;
+} PARAMETERS_JOURNAL_SECTOR_T;
+
+typedef struct
+{
+    unsigned char op;
+    PARAMETERS_CELL_T cell;
+    PARAMETERS_CHECK_T check;
+} PARAMETERS_JOURNAL_RECORD_T;
+
+// head of a ROM image of the bank mode, see Parameters_Bank_Select
+typedef struct
+{
+    unsigned short magic;
+    unsigned int sequence;
+    PARAMETERS_CHECK_T check;
+} PARAMETERS_BANK_T;
 #pragma pack()
 
+// a deleted cell kept in place by the tombstone delete mode
+#define PARAMETERS_TYPE_TOMBSTONE 0xFF
+#define PARAMETERS_IS_TOMBSTONE(cell) ((cell)->name[0] == EMPTY_BYTE && (cell)->type == PARAMETERS_TYPE_TOMBSTONE)
+
+#define PARAMETERS_BANK_MAGIC 0xBA4C
+
+#define PARAMETERS_JOURNAL_ERASED 0xFF
+#define PARAMETERS_JOURNAL_SET 0x01
+#define PARAMETERS_JOURNAL_DEL 0x02
+
+// write-behind record of the table information alone, no cell has this index
+#define PARAMETERS_ASYNC_INFO 0xFFFF
+
+// a change that leaves no cell behind, such as a deletion that moved the following cells
+#define PARAMETERS_NO_CELL 0xFFFF
+
+// identifier and type of a cell, the packed format follows them with only the bytes the type needs
+#define PARAMETERS_CELL_HEAD (sizeof(PARAMETERS_CELL_T) - 4)
+
 /**
- * @description:                                Synchronizing each other's cell data into RAM or ROM
- * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management module
+ * @description:                                Bytes taken by a value of a type
+ * @param       {unsigned char} type            PARAMETERS_TYPE_T
+ * @return      {*}                             0 for an unknown type
+ * @note       :
+ */
+static unsigned char Parameters_Type_Width(unsigned char type)
+{
+    switch (type)
+    {
+    case PARAMETERS_TYPE_UINT8:
+    case PARAMETERS_TYPE_INT8:
+        return 1;
+    case PARAMETERS_TYPE_UINT16:
+    case PARAMETERS_TYPE_INT16:
+        return 2;
+    case PARAMETERS_TYPE_UINT32:
+    case PARAMETERS_TYPE_INT32:
+    case PARAMETERS_TYPE_F32:
+        return 4;
+    case PARAMETERS_TYPE_UINT64:
+    case PARAMETERS_TYPE_INT64:
+    case PARAMETERS_TYPE_F64:
+        return 8;
+
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @description:                                Offset of a cell in the block
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell, up to used_number in the packed format
+ * @return      {*}
+ * @note       :                                The packed format looks the offset up in offset_map
+ */
+static unsigned int Parameters_Cell_Offset(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    if (moudule->config.offset_map != NULL)
+    {
+        return moudule->config.offset_map[index];
+    }
+    return index * sizeof(PARAMETERS_CELL_T);
+}
+
+/**
+ * @description:                                Address of a cell in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                data of a packed cell only holds the width of its type
+ */
+static PARAMETERS_CELL_T *Parameters_Cell(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    return (PARAMETERS_CELL_T *)(moudule->block_start + Parameters_Cell_Offset(moudule, index));
+}
+
+/**
+ * @description:                                Bytes taken by a used cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :
+ */
+static unsigned int Parameters_Cell_Size(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    if (moudule->config.offset_map != NULL)
+    {
+        return PARAMETERS_CELL_HEAD + Parameters_Type_Width(Parameters_Cell(moudule, index)->type);
+    }
+    return sizeof(PARAMETERS_CELL_T);
+}
+
+/**
+ * @description:                                Check that one more cell can be placed at an index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
  * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                For the packed format the smallest cell, Parameters_Creat checks its width
+ */
+static bool Parameters_Cell_Fits(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    if (moudule->config.offset_map != NULL)
+    {
+        return index <= moudule->table_info.used_number &&
+               (unsigned int)index + 1 < Parameters_Offset_Count(moudule->block_size) &&
+               moudule->config.offset_map[index] + PARAMETERS_CELL_HEAD + 1 <= moudule->block_size;
+    }
+    return (index + 1) * sizeof(PARAMETERS_CELL_T) < moudule->block_size;
+}
+
+/**
+ * @description:                                Type of a cell whose value can be read
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_CELL_T} *cell       cell in RAM
+ * @return      {*}                             type, 0 if the value would run past the block
+ * @note       :                                A seqlock reader may see a cell a writer is moving, it retries later
+ */
+static unsigned char Parameters_Cell_Type(PARAMETERS_CB_T *moudule, PARAMETERS_CELL_T *cell)
+{
+    unsigned char type = cell->type;
+
+    if (cell->data + Parameters_Type_Width(type) > moudule->block_start + moudule->block_size)
+    {
+        return 0;
+    }
+    return type;
+}
+
+#if PARAMETERS_STATS
+#define PARAMETERS_STAT_ADD(moudule, field, value) ((moudule)->stats.field += (value))
+#else
+#define PARAMETERS_STAT_ADD(moudule, field, value) ((void)0)
+#endif
+
+/**
+ * @description:                                Call Write_2_ROM or Read_From_ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management module
  * @param       {unsigned char} operate         type of operate <1> RAM to ROM   <2> ROM to RAM
- * @param       {unsigned char} max_retry       max retry count
+ * @param       {unsigned char} *data           bytes in RAM
+ * @param       {unsigned int} offset           offset in ROM
+ * @param       {unsigned int} size             number of bytes
  * @return      {*}                             success or fail
- * @note       :
+ * @note       :                                Every ROM access goes through here to be counted
  */
-static bool Parameters_Cell_SYNC(PARAMETERS_CB_T *moudule, unsigned short index, unsigned char operate, unsigned char max_retry)
+static bool Parameters_ROM(PARAMETERS_CB_T *moudule, unsigned char operate, unsigned char *data,
+                           unsigned int offset, unsigned int size)
 {
-    bool status = true;
-    bool (*operate_fun)(unsigned char *, unsigned int, unsigned int);
+#if PARAMETERS_STATS
+    unsigned long start = PARAMETERS_STATS_CLOCK();
+    bool status;
 
-    switch (operate)
+    if (operate == 1)
     {
-    case 1:
-        operate_fun = moudule->Write_2_ROM;
-        break;
-    case 2:
-        operate_fun = moudule->Read_From_ROM;
-        break;
+        status = moudule->Write_2_ROM(data, offset, size);
+        moudule->stats.write_calls++;
+        moudule->stats.write_bytes += size;
+        moudule->stats.write_time += PARAMETERS_STATS_CLOCK() - start;
+    }
+    else
+    {
+        status = moudule->Read_From_ROM(data, offset, size);
+        moudule->stats.read_calls++;
+        moudule->stats.read_bytes += size;
+        moudule->stats.read_time += PARAMETERS_STATS_CLOCK() - start;
+    }
+    return status;
+#else
+    return operate == 1 ? moudule->Write_2_ROM(data, offset, size) : moudule->Read_From_ROM(data, offset, size);
+#endif
+}
 
-    default:
-        break;
+/**
+ * @description:                                Call checkout
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management module
+ * @param       {unsigned char} *data           bytes to hash
+ * @param       {unsigned int} size             number of bytes
+ * @return      {*}                             check value
+ * @note       :
+ */
+static PARAMETERS_CHECK_T Parameters_Checkout(PARAMETERS_CB_T *moudule, unsigned char *data, unsigned int size)
+{
+#if PARAMETERS_STATS
+    unsigned long start = PARAMETERS_STATS_CLOCK();
+    PARAMETERS_CHECK_T check = moudule->checkout(data, size);
+
+    moudule->stats.hashed_bytes += size;
+    moudule->stats.checkout_time += PARAMETERS_STATS_CLOCK() - start;
+    return check;
+#else
+    return moudule->checkout(data, size);
+#endif
+}
+
+/**
+ * @description:                                Synchronizing each other's bytes of the block into RAM or ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management module
+ * @param       {unsigned int} offset           offset in the block
+ * @param       {unsigned int} size             number of bytes
+ * @param       {unsigned char} operate         type of operate <1> RAM to ROM   <2> ROM to RAM
+ * @param       {unsigned char} max_retry       max retry count
+ * @return      {*}                             success or fail
+ * @note       :                                Failures are left to the caller to report
+ */
+static bool Parameters_Bytes_SYNC(PARAMETERS_CB_T *moudule, unsigned int offset, unsigned int size,
+                                  unsigned char operate, unsigned char max_retry)
+{
+    while (max_retry)
+    {
+        if (Parameters_ROM(moudule, operate, moudule->block_start + offset,
+                           moudule->ROM_start_offset + sizeof(PARAMETERS_TABLE_INFO_T) + offset, size))
+        {
+            return true;
+        }
+        max_retry--;
+        PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
     }
+    PARAMETERS_STAT_ADD(moudule, failures, 1);
+    return false;
+}
+
+/**
+ * @description:                                Synchronizing each other's data of consecutive cells into RAM or ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management module
+ * @param       {unsigned short} index          index of the first cell
+ * @param       {unsigned short} number         number of cells
+ * @param       {unsigned char} operate         type of operate <1> RAM to ROM   <2> ROM to RAM
+ * @param       {unsigned char} max_retry       max retry count
+ * @return      {*}                             success or fail
+ * @note       :                                The cells are transferred with a single callback invocation
+ */
+static bool Parameters_Range_SYNC(PARAMETERS_CB_T *moudule, unsigned short index, unsigned short number,
+                                  unsigned char operate, unsigned char max_retry)
+{
+    bool status = true;
+    unsigned int start = Parameters_Cell_Offset(moudule, index);
+    unsigned int end = Parameters_Cell_Offset(moudule, index + number);
 
     // Address out of bounds checking
-    if ((index + 1) * sizeof(PARAMETERS_CELL_T) > moudule->block_size)
+    if (end > moudule->block_size)
     {
         printf("Parameters 0X%x index out!error!\n", (uintptr_t)moudule);
         status = false;
     }
-    else
+    else if (!Parameters_Bytes_SYNC(moudule, start, end - start, operate, max_retry))
     {
-        while (max_retry)
-        {
-            if (operate_fun(moudule->block_start + index * sizeof(PARAMETERS_CELL_T),
-                            moudule->ROM_start_offset + sizeof(PARAMETERS_TABLE_INFO_T) + index * sizeof(PARAMETERS_CELL_T),
-                            sizeof(PARAMETERS_CELL_T)))
-            {
-                break;
-            }
-            else
-            {
-                max_retry--;
-            }
-        }
-        if (max_retry == 0)
-        {
-            printf("Parameters 0X%x SYNC cell:%d failed! type %d\n", (uintptr_t)moudule, index, operate);
-            status = false;
-        }
+        printf("Parameters 0X%x SYNC cell:%d-%d failed! type %d\n", (uintptr_t)moudule, index, index + number - 1, operate);
+        status = false;
     }
     return status;
 }
 
+/**
+ * @description:                                Synchronizing each other's cell data into RAM or ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management module
+ * @param       {unsigned short} index          index of cell
+ * @param       {unsigned char} operate         type of operate <1> RAM to ROM   <2> ROM to RAM
+ * @param       {unsigned char} max_retry       max retry count
+ * @return      {*}                             success or fail
+ * @note       :
+ */
+static bool Parameters_Cell_SYNC(PARAMETERS_CB_T *moudule, unsigned short index, unsigned char operate, unsigned char max_retry)
+{
+    return Parameters_Range_SYNC(moudule, index, 1, operate, max_retry);
+}
+
 /**
  * @description:                                Synchronizing each other's moudule information into RAM or ROM
  * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
@@ -90,36 +342,24 @@ static bool Parameters_Cell_SYNC(PARAMETERS_CB_T *moudule, unsigned short index,
 static bool Parameters_Info_SYNC(PARAMETERS_CB_T *moudule, unsigned char operate, unsigned char max_retry)
 {
     bool status = true;
-    bool (*operate_fun)(unsigned char *, unsigned int, unsigned int);
-
-    switch (operate)
-    {
-    case 1:
-        operate_fun = moudule->Write_2_ROM;
-        break;
-    case 2:
-        operate_fun = moudule->Read_From_ROM;
-        break;
-
-    default:
-        break;
-    }
 
     while (max_retry)
     {
-        if (operate_fun((unsigned char *)&moudule->table_info,
-                        moudule->ROM_start_offset,
-                        sizeof(PARAMETERS_TABLE_INFO_T)))
+        if (Parameters_ROM(moudule, operate, (unsigned char *)&moudule->table_info,
+                           moudule->ROM_start_offset,
+                           sizeof(PARAMETERS_TABLE_INFO_T)))
         {
             break;
         }
         else
         {
             max_retry--;
+            PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
         }
     }
     if (max_retry == 0)
     {
+        PARAMETERS_STAT_ADD(moudule, failures, 1);
         printf("Parameters 0X%x SYNC info failed! type :%d\n", (uintptr_t)moudule, operate);
         status = false;
     }
@@ -127,351 +367,4052 @@ static bool Parameters_Info_SYNC(PARAMETERS_CB_T *moudule, unsigned char operate
 }
 
 /**
- * @description:                                Search for an existing identifier cell or an empty cell
- * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
- * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
- * @param       {unsigned short} *index         The index of the found cell in the block
- * @return      {*}                             success or fail
+ * @description:                                Hash of a string identifier
+ * @param       {char} *name                    String identifier, only the first 16 characters are used
+ * @return      {*}                             FNV-1a hash of the identifier
  * @note       :
  */
-static bool Parameters_Search(PARAMETERS_CB_T *moudule, char *name, unsigned short *index)
+unsigned int Parameters_Hash_Name(const char *name)
 {
-    unsigned char *search = moudule->block_start;
-    bool status = false;
-    char temp[17];
+    unsigned int hash = 2166136261u;
+    unsigned char count = 0;
 
-    *index = 0;
-    temp[16] = '\0';
-    while (((*index) + 1) * sizeof(PARAMETERS_CELL_T) < moudule->block_size)
+    while (count < 16 && name[count] != EMPTY_BYTE)
     {
-        memcpy(temp, search, 16);
+        hash ^= (unsigned char)name[count];
+        hash *= 16777619u;
+        count++;
+    }
+    return hash;
+}
+
+/**
+ * @description:                                Compare the identifier stored in a cell with a string
+ * @param       {char} *cell_name               16 bytes identifier field of a cell, not always '\0' terminated
+ * @param       {char} *name                    String identifier
+ * @return      {*}                             equal or not
+ * @note       :
+ */
+static bool Parameters_Name_Equal(const char *cell_name, const char *name)
+{
+    if (strncmp(cell_name, name, 16) != 0)
+    {
+        return false;
+    }
+    return memchr(cell_name, EMPTY_BYTE, 16) != NULL || name[16] == EMPTY_BYTE;
+}
+
+/**
+ * @description:                                Find an identifier among the slots of the name block
+ * @param       {unsigned char} *names          first slot, 16 byte aligned
+ * @param       {unsigned short} number         number of slots
+ * @param       {unsigned char} *key            identifier padded with '\0' to 16 bytes
+ * @return      {*}                             index of the first equal slot, number if there is none
+ * @note       :
+ */
+static unsigned short Parameters_Name_Scan(unsigned char (*names)[16], unsigned short number, const unsigned char *key)
+{
+    unsigned short index;
+#if PARAMETERS_SIMD && defined(__SSE2__)
+    __m128i target = _mm_loadu_si128((const __m128i *)key);
+
+    for (index = 0; index < number; index++)
+    {
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)names[index]), target)) == 0xFFFF)
+        {
+            break;
+        }
+    }
+#elif PARAMETERS_SIMD && defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t target = vld1q_u8(key);
+
+    for (index = 0; index < number; index++)
+    {
+        if (vminvq_u8(vceqq_u8(vld1q_u8(names[index]), target)) == 0xFF)
+        {
+            break;
+        }
+    }
+#else
+    uint64_t target[2], slot[2];
+
+    memcpy(target, key, 16);
+    for (index = 0; index < number; index++)
+    {
+        memcpy(slot, names[index], 16);
+        if (slot[0] == target[0] && slot[1] == target[1])
+        {
+            break;
+        }
+    }
+#endif
+    return index;
+}
+
+/**
+ * @description:                                Copy the identifier of a cell into the name block
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                A deleted cell leaves an empty slot
+ */
+static void Parameters_Name_Set(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    if (moudule->config.name_block != NULL)
+    {
+        memcpy(moudule->config.name_block[index], Parameters_Cell(moudule, index)->name, 16);
+    }
+}
+
+/**
+ * @description:                                Rebuild the name block from the cells in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :                                Called with Parameters_Hash_Build
+ */
+static void Parameters_Name_Build(PARAMETERS_CB_T *moudule)
+{
+    unsigned short index;
+
+    for (index = 0; moudule->config.name_block != NULL && index < moudule->table_info.used_number; index++)
+    {
+        Parameters_Name_Set(moudule, index);
+    }
+}
+
+/**
+ * @description:                                Add a cell to the hash index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                The index must not be in the hash index yet
+ */
+static void Parameters_Hash_Insert(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    PARAMETERS_CELL_T *cell = Parameters_Cell(moudule, index);
+    unsigned int mask = moudule->config.hash_size - 1;
+    unsigned int slot = Parameters_Hash_Name(cell->name) & mask;
+
+    while (moudule->config.hash_block[slot] != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    moudule->config.hash_block[slot] = index + 1;
+}
+
+/**
+ * @description:                                Rebuild the hash index from the cells in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :                                Called after loading the table and after cells are moved
+ */
+static void Parameters_Hash_Build(PARAMETERS_CB_T *moudule)
+{
+    unsigned short index;
+
+    if (moudule->config.hash_block == NULL)
+    {
+        return;
+    }
+
+    memset(moudule->config.hash_block, 0, moudule->config.hash_size * sizeof(unsigned short));
+    for (index = 0; index < moudule->table_info.used_number; index++)
+    {
+        if (Parameters_Cell(moudule, index)->name[0] != EMPTY_BYTE)
+        {
+            Parameters_Hash_Insert(moudule, index);
+        }
+    }
+}
+
+/**
+ * @description:                                Remove a cell from the hash index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell, its identifier must still be in RAM
+ * @return      {*}
+ * @note       :                                Following entries of the probe sequence are shifted back into the hole
+ */
+static void Parameters_Hash_Remove(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    PARAMETERS_CELL_T *cell = Parameters_Cell(moudule, index);
+    unsigned int mask = moudule->config.hash_size - 1;
+    unsigned int hole = Parameters_Hash_Name(cell->name) & mask;
+    unsigned int slot, home;
+
+    while (moudule->config.hash_block[hole] != index + 1)
+    {
+        if (moudule->config.hash_block[hole] == 0)
+        {
+            return;
+        }
+        hole = (hole + 1) & mask;
+    }
+
+    slot = (hole + 1) & mask;
+    while (moudule->config.hash_block[slot] != 0)
+    {
+        cell = Parameters_Cell(moudule, moudule->config.hash_block[slot] - 1);
+        home = Parameters_Hash_Name(cell->name) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            moudule->config.hash_block[hole] = moudule->config.hash_block[slot];
+            hole = slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    moudule->config.hash_block[hole] = 0;
+}
+
+/**
+ * @description:                                Compare the identifier of a cell with a key
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @param       {unsigned char} *key            identifier padded with '\0' to 16 bytes
+ * @return      {*}                             as memcmp, the order of the sorted index
+ * @note       :
+ */
+static int Parameters_Sort_Compare(PARAMETERS_CB_T *moudule, unsigned short index, const unsigned char *key)
+{
+    return memcmp(Parameters_Cell(moudule, index)->name, key, 16);
+}
+
+/**
+ * @description:                                First position of the sorted index not ordered before a key
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} *key            identifier padded with '\0' to 16 bytes
+ * @return      {*}                             position, sort_number if every identifier is before the key
+ * @note       :                                A seqlock reader may see the map a writer is moving, it retries later
+ */
+static unsigned short Parameters_Sort_Lower(PARAMETERS_CB_T *moudule, const unsigned char *key)
+{
+    unsigned short low = 0;
+    unsigned short high = moudule->sort_number;
+    unsigned short middle, index;
+
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        index = moudule->config.sort_map[middle];
+        if (Parameters_Cell_Fits(moudule, index) && Parameters_Sort_Compare(moudule, index, key) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @description:                                Add a cell to the sorted index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                The index must not be in the sorted index yet
+ */
+static void Parameters_Sort_Insert(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    unsigned short position;
+
+    if (moudule->config.sort_map == NULL)
+    {
+        return;
+    }
+
+    position = Parameters_Sort_Lower(moudule, (unsigned char *)Parameters_Cell(moudule, index)->name);
+    memmove(moudule->config.sort_map + position + 1, moudule->config.sort_map + position,
+            (moudule->sort_number - position) * sizeof(unsigned short));
+    moudule->config.sort_map[position] = index;
+    moudule->sort_number++;
+}
+
+/**
+ * @description:                                Remove a cell from the sorted index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell, its identifier must still be in RAM
+ * @return      {*}
+ * @note       :
+ */
+static void Parameters_Sort_Remove(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    unsigned short position;
+
+    if (moudule->config.sort_map == NULL)
+    {
+        return;
+    }
+
+    position = Parameters_Sort_Lower(moudule, (unsigned char *)Parameters_Cell(moudule, index)->name);
+    while (position < moudule->sort_number && moudule->config.sort_map[position] != index)
+    {
+        position++;
+    }
+    if (position < moudule->sort_number)
+    {
+        moudule->sort_number--;
+        memmove(moudule->config.sort_map + position, moudule->config.sort_map + position + 1,
+                (moudule->sort_number - position) * sizeof(unsigned short));
+    }
+}
+
+/**
+ * @description:                                Move an entry of the sorted index down a heap
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned int} root             position of the entry
+ * @param       {unsigned int} number           entries in the heap
+ * @return      {*}
+ * @note       :
+ */
+static void Parameters_Sort_Sift(PARAMETERS_CB_T *moudule, unsigned int root, unsigned int number)
+{
+    unsigned short *map = moudule->config.sort_map;
+    unsigned int child;
+    unsigned short temp;
+
+    while ((child = root * 2 + 1) < number)
+    {
+        if (child + 1 < number &&
+            Parameters_Sort_Compare(moudule, map[child], (unsigned char *)Parameters_Cell(moudule, map[child + 1])->name) < 0)
+        {
+            child++;
+        }
+        if (Parameters_Sort_Compare(moudule, map[root], (unsigned char *)Parameters_Cell(moudule, map[child])->name) >= 0)
+        {
+            break;
+        }
+        temp = map[root];
+        map[root] = map[child];
+        map[child] = temp;
+        root = child;
+    }
+}
+
+/**
+ * @description:                                Rebuild the sorted index from the cells in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :                                Called with Parameters_Hash_Build. Heap sort in place, the map is the only memory
+ */
+static void Parameters_Sort_Build(PARAMETERS_CB_T *moudule)
+{
+    unsigned short *map = moudule->config.sort_map;
+    unsigned short index, temp;
+    unsigned short number = 0;
+
+    if (map == NULL)
+    {
+        return;
+    }
+
+    for (index = 0; index < moudule->table_info.used_number; index++)
+    {
+        if (Parameters_Cell(moudule, index)->name[0] != EMPTY_BYTE)
+        {
+            map[number++] = index;
+        }
+    }
+
+    for (index = number / 2; index > 0; index--)
+    {
+        Parameters_Sort_Sift(moudule, index - 1, number);
+    }
+    for (index = number; index > 1; index--)
+    {
+        temp = map[0];
+        map[0] = map[index - 1];
+        map[index - 1] = temp;
+        Parameters_Sort_Sift(moudule, 0, index - 1);
+    }
+    moudule->sort_number = number;
+}
+
+/**
+ * @description:                                Get a tombstone to reuse for a new cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} *index         index of the tombstone
+ * @return      {*}                             false if the table has no tombstone
+ * @note       :                                The small free list is refilled from RAM when it runs empty
+ */
+static bool Parameters_Free_Peek(PARAMETERS_CB_T *moudule, unsigned short *index)
+{
+    unsigned short search;
+
+    if (moudule->free_number == 0)
+    {
+        return false;
+    }
+
+    if (moudule->free_cached == 0)
+    {
+        for (search = 0; search < moudule->table_info.used_number && moudule->free_cached < PARAMETERS_FREE_CACHE; search++)
+        {
+            if (PARAMETERS_IS_TOMBSTONE(Parameters_Cell(moudule, search)))
+            {
+                moudule->free_cache[moudule->free_cached++] = search;
+            }
+        }
+    }
+
+    *index = moudule->free_cache[moudule->free_cached - 1];
+    return true;
+}
+
+/**
+ * @description:                                Count the tombstones of the table
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :                                Called after loading the table and after cells are moved
+ */
+static void Parameters_Free_Build(PARAMETERS_CB_T *moudule)
+{
+    unsigned short index;
+
+    moudule->free_number = 0;
+    moudule->free_cached = 0;
+    moudule->index_map_valid = false;
+    for (index = 0; index < moudule->table_info.used_number; index++)
+    {
+        if (PARAMETERS_IS_TOMBSTONE(Parameters_Cell(moudule, index)))
+        {
+            moudule->free_number++;
+        }
+    }
+}
+
+/**
+ * @description:                                Number of pages of the lazy loading mode
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :
+ */
+static unsigned short Parameters_Page_Number(PARAMETERS_CB_T *moudule)
+{
+    return Parameters_Page_Count(moudule->block_size, moudule->config.lazy_page);
+}
+
+/**
+ * @description:                                Synchronizing each other's page check values into RAM or ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} page           index of the first page
+ * @param       {unsigned short} number         number of pages
+ * @param       {unsigned char} operate         type of operate <1> RAM to ROM   <2> ROM to RAM
+ * @return      {*}                             success or fail
+ * @note       :                                The page check values follow the space of all cells in ROM
+ */
+static bool Parameters_Page_SYNC(PARAMETERS_CB_T *moudule, unsigned short page, unsigned short number, unsigned char operate)
+{
+    unsigned char max_retry = 4;
+
+    while (max_retry)
+    {
+        if (Parameters_ROM(moudule, operate, (unsigned char *)(moudule->config.page_check + page),
+                           moudule->ROM_start_offset + sizeof(PARAMETERS_TABLE_INFO_T) +
+                               (moudule->block_size / sizeof(PARAMETERS_CELL_T)) * sizeof(PARAMETERS_CELL_T) +
+                               page * sizeof(PARAMETERS_CHECK_T),
+                           number * sizeof(PARAMETERS_CHECK_T)))
+        {
+            return true;
+        }
+        max_retry--;
+        PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
+    }
+    PARAMETERS_STAT_ADD(moudule, failures, 1);
+
+    printf("Parameters 0X%x SYNC page:%d failed! type %d\n", (uintptr_t)moudule, page, operate);
+    return false;
+}
+
+/**
+ * @description:                                Check value of the used cells of a page in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} page           index of page
+ * @return      {*}
+ * @note       :
+ */
+static PARAMETERS_CHECK_T Parameters_Page_Check(PARAMETERS_CB_T *moudule, unsigned short page)
+{
+    unsigned int first = page * moudule->config.lazy_page;
+    unsigned int number = 0;
+
+    if (first < moudule->table_info.used_number)
+    {
+        number = moudule->table_info.used_number - first;
+        number = number < moudule->config.lazy_page ? number : moudule->config.lazy_page;
+    }
+    return Parameters_Checkout(moudule, moudule->block_start + first * sizeof(PARAMETERS_CELL_T), number * sizeof(PARAMETERS_CELL_T));
+}
+
+/**
+ * @description:                                Recompute the check values of pages and of the table
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} page           index of the first changed page
+ * @param       {unsigned short} number         number of changed pages
+ * @return      {*}
+ * @note       :                                In the lazy loading mode check_value covers the page check values
+ */
+static void Parameters_Page_Refresh(PARAMETERS_CB_T *moudule, unsigned short page, unsigned short number)
+{
+    while (number)
+    {
+        moudule->config.page_check[page] = Parameters_Page_Check(moudule, page);
+        page++;
+        number--;
+    }
+    moudule->table_info.check_value = Parameters_Checkout(moudule, (unsigned char *)moudule->config.page_check,
+                                                        Parameters_Page_Number(moudule) * sizeof(PARAMETERS_CHECK_T));
+}
+
+/**
+ * @description:                                Load a page of cells from ROM and verify it
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} page           index of page
+ * @return      {*}                             success or fail
+ * @note       :                                The cells of the page are added to the hash index
+ */
+static bool Parameters_Page_Load(PARAMETERS_CB_T *moudule, unsigned short page)
+{
+    unsigned short first = page * moudule->config.lazy_page;
+    unsigned short number = 0;
+    unsigned short index;
+
+    if (first < moudule->table_info.used_number)
+    {
+        number = moudule->table_info.used_number - first;
+        number = number < moudule->config.lazy_page ? number : moudule->config.lazy_page;
+    }
+
+    if (number != 0 && !Parameters_Range_SYNC(moudule, first, number, 2, 4))
+    {
+        return false;
+    }
+    if (Parameters_Page_Check(moudule, page) != moudule->config.page_check[page])
+    {
+        printf("Parameters 0X%x page:%d checkout error!\n", (uintptr_t)moudule, page);
+        memset(moudule->block_start + first * sizeof(PARAMETERS_CELL_T), EMPTY_BYTE, number * sizeof(PARAMETERS_CELL_T));
+        return false;
+    }
+
+    moudule->config.page_loaded[page >> 3] |= 1 << (page & 7);
+    for (index = first; moudule->config.hash_block != NULL && index < first + number; index++)
+    {
+        Parameters_Hash_Insert(moudule, index);
+    }
+    return true;
+}
+
+/**
+ * @description:                                Make sure the page holding a cell is in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}                             false if the page cannot be loaded
+ * @note       :                                Always true when the lazy loading mode is off
+ */
+static bool Parameters_Page_Ensure(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    unsigned short page;
+
+    if (moudule->config.lazy_page == 0)
+    {
+        return true;
+    }
+
+    page = index / moudule->config.lazy_page;
+    if (moudule->config.page_loaded[page >> 3] & (1 << (page & 7)))
+    {
+        return true;
+    }
+    return Parameters_Page_Load(moudule, page);
+}
+
+/**
+ * @description:                                Search the hash index for an existing identifier cell or an empty cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier
+ * @param       {unsigned int} hash             Parameters_Hash_Name of the identifier
+ * @param       {unsigned short} *index         The index of the found cell in the block
+ * @return      {*}                             success or fail
+ * @note       :                                Same result as the linear search, cells are always packed from index 0
+ */
+static bool Parameters_Hash_Search(PARAMETERS_CB_T *moudule, char *name, unsigned int hash, unsigned short *index)
+{
+    PARAMETERS_CELL_T *cell;
+    unsigned int mask = moudule->config.hash_size - 1;
+    unsigned int slot = hash & mask;
+
+    while (moudule->config.hash_block[slot] != 0)
+    {
+        *index = moudule->config.hash_block[slot] - 1;
+        PARAMETERS_STAT_ADD(moudule, probes, 1);
+        // a seqlock reader may see a slot a writer is rebuilding, it retries later
+        if (!Parameters_Cell_Fits(moudule, *index))
+        {
+            return false;
+        }
+        cell = Parameters_Cell(moudule, *index);
+        if (Parameters_Name_Equal(cell->name, name))
+        {
+            return true;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // the hash index only knows loaded pages, look through the others
+    for (slot = 0; moudule->config.lazy_page != 0 && slot * moudule->config.lazy_page < moudule->table_info.used_number; slot++)
+    {
+        if ((moudule->config.page_loaded[slot >> 3] & (1 << (slot & 7))) || !Parameters_Page_Load(moudule, slot))
+        {
+            continue;
+        }
+        for (*index = slot * moudule->config.lazy_page;
+             *index < moudule->table_info.used_number && *index < (slot + 1) * moudule->config.lazy_page; (*index)++)
+        {
+            cell = Parameters_Cell(moudule, *index);
+            PARAMETERS_STAT_ADD(moudule, probes, 1);
+            if (Parameters_Name_Equal(cell->name, name))
+            {
+                return true;
+            }
+        }
+    }
+
+    *index = moudule->table_info.used_number;
+    return Parameters_Cell_Fits(moudule, *index) && Parameters_Page_Ensure(moudule, *index);
+}
+
+/**
+ * @description:                                Search the sorted index for an existing identifier cell or an empty cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier
+ * @param       {unsigned short} *index         The index of the found cell in the block
+ * @return      {*}                             success or fail
+ * @note       :                                Same result as the linear search in O(log n) compares
+ */
+static bool Parameters_Sort_Search(PARAMETERS_CB_T *moudule, char *name, unsigned short *index)
+{
+    unsigned short position;
+    unsigned char key[16];
+#if PARAMETERS_STATS
+    unsigned short number;
+
+    for (number = moudule->sort_number; number != 0; number >>= 1)
+    {
+        PARAMETERS_STAT_ADD(moudule, probes, 1);
+    }
+#endif
+
+    memset(key, EMPTY_BYTE, 16);
+    strncpy((char *)key, name, 16);
+    position = Parameters_Sort_Lower(moudule, key);
+    if (position < moudule->sort_number)
+    {
+        *index = moudule->config.sort_map[position];
+        // a seqlock reader may see an entry a writer is moving, the cell decides
+        if (Parameters_Cell_Fits(moudule, *index) && Parameters_Name_Equal(Parameters_Cell(moudule, *index)->name, name))
+        {
+            return true;
+        }
+    }
+
+    *index = moudule->table_info.used_number;
+    return Parameters_Cell_Fits(moudule, *index);
+}
+
+/**
+ * @description:                                Search for an existing identifier cell or an empty cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {unsigned short} *index         The index of the found cell in the block
+ * @return      {*}                             success or fail
+ * @note       :                                Does not change the module, tombstones are left to Parameters_Creat
+ */
+static bool Parameters_Find(PARAMETERS_CB_T *moudule, char *name, unsigned short *index)
+{
+    unsigned short used = moudule->table_info.used_number;
+    unsigned short start;
+    unsigned char *search;
+    bool status = false;
+    char temp[17];
+
+    if (moudule->config.hash_block != NULL)
+    {
+        return Parameters_Hash_Search(moudule, name, Parameters_Hash_Name(name), index);
+    }
+
+    if (moudule->config.sort_map != NULL)
+    {
+        return Parameters_Sort_Search(moudule, name, index);
+    }
+
+    if (moudule->config.name_block != NULL && name[0] != EMPTY_BYTE)
+    {
+        memset(temp, EMPTY_BYTE, 16);
+        strncpy(temp, name, 16);
+        for (start = 0; start < used; start = *index + 1)
+        {
+            *index = start + Parameters_Name_Scan(moudule->config.name_block + start, used - start, (unsigned char *)temp);
+            PARAMETERS_STAT_ADD(moudule, probes, *index - start + (*index < used));
+            // a seqlock reader may see the slot of a cell a writer is changing, the cell decides
+            if (*index < used && Parameters_Name_Equal(Parameters_Cell(moudule, *index)->name, name))
+            {
+                return true;
+            }
+        }
+        *index = used;
+        return Parameters_Cell_Fits(moudule, *index);
+    }
+
+    *index = 0;
+    temp[16] = '\0';
+    while (Parameters_Cell_Fits(moudule, *index))
+    {
+        if (!Parameters_Page_Ensure(moudule, *index))
+        {
+            return false;
+        }
+        search = (unsigned char *)Parameters_Cell(moudule, *index);
+        memcpy(temp, search, 16);
+        PARAMETERS_STAT_ADD(moudule, probes, 1);
+
+        if (strcmp(temp, name) == 0)
+        {
+            return true;
+        }
+        if (temp[0] == EMPTY_BYTE && search[16] != PARAMETERS_TYPE_TOMBSTONE)
+        {
+            status = true;
+            break;
+        }
+        (*index)++;
+    }
+    return status;
+}
+
+/**
+ * @description:                                Search for an existing identifier cell or an empty cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {unsigned short} *index         The index of the found cell in the block
+ * @return      {*}                             success or fail
+ * @note       :                                Counts the lookup, see Parameters_Find
+ */
+static bool Parameters_Search(PARAMETERS_CB_T *moudule, char *name, unsigned short *index)
+{
+#if PARAMETERS_STATS
+    unsigned long probes = moudule->stats.probes;
+    bool status = Parameters_Find(moudule, name, index);
+
+    probes = moudule->stats.probes - probes;
+    moudule->stats.lookups++;
+    moudule->stats.max_probe = probes > moudule->stats.max_probe ? probes : moudule->stats.max_probe;
+    return status;
+#else
+    return Parameters_Find(moudule, name, index);
+#endif
+}
+
+/**
+ * @description:                                Assign values to a block of data by type
+ * @param       {void} *dst                     Destation
+ * @param       {void} *src                     Source
+ * @param       {PARAMETERS_TYPE_T} type
+ * @return      {*}                             success or fail
+ * @note       :
+ */
+static bool Parameters_Load_value(void *dst, void *src, PARAMETERS_TYPE_T type)
+{
+    ISR_LOCK();
+
+    bool status = true;
+    switch (type)
+    {
+    case PARAMETERS_TYPE_UINT8:
+    case PARAMETERS_TYPE_INT8:
+        memcpy(dst, src, 1);
+        break;
+    case PARAMETERS_TYPE_UINT16:
+    case PARAMETERS_TYPE_INT16:
+        memcpy(dst, src, 2);
+        break;
+    case PARAMETERS_TYPE_UINT32:
+    case PARAMETERS_TYPE_INT32:
+    case PARAMETERS_TYPE_F32:
+        memcpy(dst, src, 4);
+        break;
+    case PARAMETERS_TYPE_UINT64:
+    case PARAMETERS_TYPE_INT64:
+    case PARAMETERS_TYPE_F64:
+        memcpy(dst, src, 8);
+        break;
+
+    default:
+        status = false;
+        break;
+    }
+
+    ISR_UNLOCK();
+    return status;
+}
+
+/**
+ * @description:                                Check value of the first cells of the table
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} number         number of cells covered
+ * @return      {*}                             check value in the configured check mode
+ * @note       :
+ */
+static PARAMETERS_CHECK_T Parameters_Check_Table(PARAMETERS_CB_T *moudule, unsigned short number)
+{
+    PARAMETERS_CHECK_T check = 0;
+    unsigned short index;
+
+    if (moudule->config.check_mode != PARAMETERS_CHECK_INCREMENTAL)
+    {
+        return Parameters_Checkout(moudule, moudule->block_start, Parameters_Cell_Offset(moudule, number));
+    }
+
+    for (index = 0; index < number; index++)
+    {
+        check += Parameters_Checkout(moudule, (unsigned char *)Parameters_Cell(moudule, index), Parameters_Cell_Size(moudule, index));
+    }
+    return check;
+}
+
+/**
+ * @description:                                Take a cell out of the check value before it is changed or deleted
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                Only the incremental check mode needs the old content of the cell
+ */
+static void Parameters_Check_Remove(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    if (moudule->config.check_mode == PARAMETERS_CHECK_INCREMENTAL && moudule->config.lazy_page == 0)
+    {
+        moudule->table_info.check_value -= Parameters_Checkout(moudule, (unsigned char *)Parameters_Cell(moudule, index),
+                                                             Parameters_Cell_Size(moudule, index));
+    }
+}
+
+/**
+ * @description:                                Put a new or changed cell into the check value
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                The whole check mode recomputes the table, used_number must be up to date.
+ *                                              The lazy loading mode recomputes the page of the cell.
+ */
+static void Parameters_Check_Add(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    if (moudule->config.lazy_page != 0)
+    {
+        Parameters_Page_Refresh(moudule, index / moudule->config.lazy_page, 1);
+    }
+    else if (moudule->config.check_mode == PARAMETERS_CHECK_INCREMENTAL)
+    {
+        moudule->table_info.check_value += Parameters_Checkout(moudule, (unsigned char *)Parameters_Cell(moudule, index),
+                                                             Parameters_Cell_Size(moudule, index));
+    }
+    else
+    {
+        moudule->table_info.check_value = Parameters_Check_Table(moudule, moudule->table_info.used_number);
+    }
+}
+
+/**
+ * @description:                                Queue changed cells for the write-behind task
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of the first changed cell
+ * @param       {unsigned short} number         number of changed cells, 0 if only the table information changed
+ * @return      {*}
+ * @note       :                                The caller holds OS_LOCK, the only producer of the ring.
+ *                                              A cell already queued is not queued again, so the ring never fills.
+ *                                              RAM must be changed before, the task may be copying the cell meanwhile.
+ */
+static void Parameters_Async_Mark(PARAMETERS_CB_T *moudule, unsigned short index, unsigned short number)
+{
+    unsigned int mask = moudule->config.async_size - 1;
+    unsigned char bit;
+
+    if (number == 0 && __sync_bool_compare_and_swap(&moudule->async_info, 0, 1))
+    {
+        moudule->config.async_ring[moudule->async_head & mask] = PARAMETERS_ASYNC_INFO;
+        PARAMETERS_BARRIER();
+        moudule->async_head++;
+    }
+
+    while (number)
+    {
+        // the mark is shared with the task, which clears it before copying the cell
+        bit = 1 << (index & 7);
+        if (__sync_fetch_and_or(&moudule->config.dirty_block[index >> 3], bit) & bit)
+        {
+            __sync_fetch_and_add(&moudule->saved_writes, 1);
+        }
+        else
+        {
+            moudule->config.async_ring[moudule->async_head & mask] = index;
+            PARAMETERS_BARRIER();
+            moudule->async_head++;
+        }
+        index++;
+        number--;
+    }
+
+    if (moudule->Async_Notify != NULL)
+    {
+        moudule->Async_Notify(moudule->async_worker);
+    }
+}
+
+/**
+ * @description:                                Defer the ROM write of cells while a batch is open or to the write-behind task
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of the first changed cell
+ * @param       {unsigned short} number         number of changed cells
+ * @return      {*}                             true if the cells are left to Parameters_Commit or Parameters_Async_Drain
+ * @note       :                                Counts the cell writes and the table information write it saves
+ */
+static bool Parameters_Batch_Mark(PARAMETERS_CB_T *moudule, unsigned short index, unsigned short number)
+{
+    if (moudule->config.async_ring != NULL)
+    {
+        Parameters_Async_Mark(moudule, index, number);
+        return true;
+    }
+
+    if (moudule->batch_depth == 0)
+    {
+        return false;
+    }
+
+    moudule->batch_pending += number + 1;
+    moudule->page_dirty = moudule->config.lazy_page != 0;
+    while (number)
+    {
+        moudule->config.dirty_block[index >> 3] |= 1 << (index & 7);
+        index++;
+        number--;
+    }
+    return true;
+}
+
+/**
+ * @description:                                Rebuild the index map from the cells in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :
+ */
+static void Parameters_Index_Build(PARAMETERS_CB_T *moudule)
+{
+    unsigned short slot;
+    unsigned short dense = 0;
+
+    for (slot = 0; slot < moudule->table_info.used_number; slot++)
+    {
+        if (!PARAMETERS_IS_TOMBSTONE(Parameters_Cell(moudule, slot)))
+        {
+            moudule->config.index_map[dense++] = slot;
+        }
+    }
+    moudule->index_map_valid = true;
+}
+
+/**
+ * @description:                                Slot in the block of the parameter at a dense index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index not counting tombstones
+ * @return      {*}                             index of the cell in the block
+ * @note       :                                The index map is rebuilt on first use after cells were created or deleted,
+ *                                              without one the table is walked. Seqlock writers rebuild it instead.
+ */
+static unsigned short Parameters_Index_Slot(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    unsigned short slot;
+    unsigned short dense = 0;
+
+    if (moudule->config.index_map != NULL && !moudule->index_map_valid && !moudule->config.seqlock)
+    {
+        Parameters_Index_Build(moudule);
+    }
+    if (moudule->config.index_map != NULL && moudule->index_map_valid)
+    {
+        return moudule->config.index_map[index];
+    }
+
+    for (slot = 0; slot < moudule->table_info.used_number; slot++)
+    {
+        if (!PARAMETERS_IS_TOMBSTONE(Parameters_Cell(moudule, slot)))
+        {
+            if (dense == index)
+            {
+                return slot;
+            }
+            dense++;
+        }
+    }
+    return slot;
+}
+
+/**
+ * @description:                                Start changing RAM seen by readers
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :                                The caller holds OS_LOCK. The sequence stays odd until Parameters_Write_End
+ */
+static void Parameters_Write_Begin(PARAMETERS_CB_T *moudule)
+{
+    if (moudule->config.seqlock)
+    {
+        moudule->sequence++;
+        PARAMETERS_BARRIER();
+    }
+}
+
+/**
+ * @description:                                Done changing RAM seen by readers
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :                                ROM is written after this, readers go on meanwhile
+ */
+static void Parameters_Write_End(PARAMETERS_CB_T *moudule)
+{
+    if (moudule->config.seqlock)
+    {
+        if (moudule->config.index_map != NULL && !moudule->index_map_valid)
+        {
+            Parameters_Index_Build(moudule);
+        }
+        PARAMETERS_BARRIER();
+        moudule->sequence++;
+    }
+}
+
+/**
+ * @description:                                Start a read of the table
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             sequence to pass to Parameters_Read_Retry
+ * @note       :                                Takes OS_LOCK when the seqlock mode is off
+ */
+static unsigned int Parameters_Read_Begin(PARAMETERS_CB_T *moudule)
+{
+    unsigned int sequence = 0;
+
+    if (!moudule->config.seqlock)
+    {
+        OS_LOCK();
+        return sequence;
+    }
+
+    do
+    {
+        sequence = moudule->sequence;
+    } while (sequence & 1);
+    PARAMETERS_BARRIER();
+    return sequence;
+}
+
+/**
+ * @description:                                Finish a read of the table
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned int} sequence         value returned by Parameters_Read_Begin
+ * @return      {*}                             true if a writer changed the table meanwhile and the read must be repeated
+ * @note       :
+ */
+static bool Parameters_Read_Retry(PARAMETERS_CB_T *moudule, unsigned int sequence)
+{
+    if (!moudule->config.seqlock)
+    {
+        OS_UNLOCK();
+        return false;
+    }
+
+    PARAMETERS_BARRIER();
+    return moudule->sequence != sequence;
+}
+
+/**
+ * @description:                                Record a change in the generation and tell the matching subscriptions
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of the changed cell, PARAMETERS_NO_CELL if it is gone
+ * @param       {const char} *name              identifier of the changed parameter, up to 16 bytes
+ * @return      {*}
+ * @note       :                                The caller holds OS_LOCK and has finished changing RAM
+ */
+static void Parameters_Changed(PARAMETERS_CB_T *moudule, unsigned short index, const char *name)
+{
+    PARAMETERS_SUBSCRIPTION_T *subscription = moudule->config.subscription_block;
+    PARAMETERS_LOG_T *log;
+    unsigned char count;
+    char id[17];
+
+    moudule->generation++;
+    if (moudule->config.version_map != NULL && index != PARAMETERS_NO_CELL)
+    {
+        moudule->config.version_map[index] = moudule->generation;
+    }
+
+    if (moudule->config.change_log != NULL && index != PARAMETERS_NO_CELL)
+    {
+        log = &moudule->config.change_log[moudule->change_head & (moudule->config.change_size - 1)];
+        if (moudule->change_head >= moudule->config.change_size && log->generation > moudule->change_floor)
+        {
+            // the entry overwritten is lost to deltas from before it
+            moudule->change_floor = log->generation;
+        }
+        log->generation = moudule->generation;
+        log->index = index;
+        moudule->change_head++;
+    }
+
+    if (subscription == NULL)
+    {
+        return;
+    }
+
+    memset(id, EMPTY_BYTE, sizeof(id));
+    strncpy(id, name, 16);
+    for (count = 0; count < moudule->config.subscription_size; count++, subscription++)
+    {
+        if (subscription->active && strncmp(id, subscription->name, subscription->length) == 0)
+        {
+            subscription->generation = moudule->generation;
+            if (subscription->notify != NULL)
+            {
+                subscription->notify(subscription->context, id, moudule->generation);
+            }
+        }
+    }
+}
+
+/**
+ * @description:                                Remove a cell from RAM and move the following cells down
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :                                Nothing is written to ROM
+ */
+static void Parameters_Cell_Remove(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    PARAMETERS_CELL_T *cell = Parameters_Cell(moudule, index);
+    unsigned short temp_index = index;
+    unsigned short position;
+    unsigned int size, end;
+
+    // every page behind the cell moves
+    while (moudule->config.lazy_page != 0 && temp_index < moudule->table_info.used_number)
+    {
+        Parameters_Page_Ensure(moudule, temp_index);
+        temp_index = (temp_index / moudule->config.lazy_page + 1) * moudule->config.lazy_page;
+    }
+    temp_index = index;
+
+    // the order of the sorted index stays, the cells behind the removed one only get a lower index
+    Parameters_Sort_Remove(moudule, index);
+    for (position = 0; moudule->config.sort_map != NULL && position < moudule->sort_number; position++)
+    {
+        if (moudule->config.sort_map[position] > index)
+        {
+            moudule->config.sort_map[position]--;
+        }
+    }
+
+    Parameters_Check_Remove(moudule, index);
+    if (moudule->config.offset_map != NULL)
+    {
+        // packed cells move down by the size of the removed one
+        size = Parameters_Cell_Size(moudule, index);
+        end = moudule->config.offset_map[moudule->table_info.used_number];
+        memmove(cell, (unsigned char *)cell + size, end - moudule->config.offset_map[index] - size);
+        memset(moudule->block_start + end - size, EMPTY_BYTE, size);
+        while (temp_index < moudule->table_info.used_number)
+        {
+            moudule->config.offset_map[temp_index] = moudule->config.offset_map[temp_index + 1] - size;
+            temp_index++;
+        }
+    }
+    else
+    {
+        memset(cell, EMPTY_BYTE, sizeof(PARAMETERS_CELL_T));
+        while (temp_index < moudule->table_info.used_number)
+        {
+            memcpy(cell, (void *)(cell + 1), sizeof(PARAMETERS_CELL_T));
+            temp_index++;
+            cell++;
+        }
+        memset(cell, EMPTY_BYTE, sizeof(PARAMETERS_CELL_T));
+    }
+
+    if (moudule->config.journal_map != NULL)
+    {
+        memmove(moudule->config.journal_map + index, moudule->config.journal_map + index + 1,
+                moudule->table_info.used_number - index - 1);
+    }
+    if (moudule->config.version_map != NULL)
+    {
+        memmove(moudule->config.version_map + index, moudule->config.version_map + index + 1,
+                (moudule->table_info.used_number - index - 1) * sizeof(unsigned int));
+        moudule->config.version_map[moudule->table_info.used_number - 1] = 0;
+    }
+
+    moudule->table_info.used_number--;
+    if (moudule->config.lazy_page != 0)
+    {
+        temp_index = index / moudule->config.lazy_page;
+        Parameters_Page_Refresh(moudule, temp_index, Parameters_Page_Number(moudule) - temp_index);
+    }
+    else if (moudule->config.check_mode != PARAMETERS_CHECK_INCREMENTAL)
+    {
+        moudule->table_info.check_value = Parameters_Check_Table(moudule, moudule->table_info.used_number);
+    }
+    // cells behind the deleted one moved down, their slots in the hash index, free list and handles are stale
+    Parameters_Hash_Build(moudule);
+    Parameters_Name_Build(moudule);
+    moudule->free_cached = 0;
+    moudule->index_map_valid = false;
+    moudule->layout_version++;
+    if (moudule->layout_version == 0)
+    {
+        moudule->layout_version = 1;
+    }
+}
+
+/**
+ * @description:                                ROM offset of a journal sector
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} sector         index of sector
+ * @return      {*}
+ * @note       :
+ */
+static unsigned int Parameters_Journal_Offset(PARAMETERS_CB_T *moudule, unsigned short sector)
+{
+    return moudule->ROM_start_offset + sector * moudule->config.journal_sector;
+}
+
+/**
+ * @description:                                Number of records that fit in a journal sector
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :
+ */
+static unsigned short Parameters_Journal_Slots(PARAMETERS_CB_T *moudule)
+{
+    return (moudule->config.journal_sector - sizeof(PARAMETERS_JOURNAL_SECTOR_T)) / sizeof(PARAMETERS_JOURNAL_RECORD_T);
+}
+
+/**
+ * @description:                                Erase a journal sector
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} sector         index of sector
+ * @return      {*}                             success or fail
+ * @note       :                                Without an Erase_ROM callback the sector is filled with 0xFF
+ */
+static bool Parameters_Journal_Erase(PARAMETERS_CB_T *moudule, unsigned short sector)
+{
+    unsigned char erased[sizeof(PARAMETERS_JOURNAL_RECORD_T)];
+    unsigned int offset = Parameters_Journal_Offset(moudule, sector);
+    unsigned int size = moudule->config.journal_sector;
+    unsigned int count;
+    unsigned char max_retry = 4;
+
+    if (moudule->config.Erase_ROM != NULL)
+    {
+        while (max_retry && !moudule->config.Erase_ROM(offset, size))
+        {
+            max_retry--;
+            PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
+        }
+    }
+    else
+    {
+        memset(erased, PARAMETERS_JOURNAL_ERASED, sizeof(erased));
+        while (size && max_retry)
+        {
+            count = size < sizeof(erased) ? size : sizeof(erased);
+            if (Parameters_ROM(moudule, 1, erased, offset, count))
+            {
+                offset += count;
+                size -= count;
+            }
+            else
+            {
+                max_retry--;
+                PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
+            }
+        }
+    }
+
+    if (max_retry == 0)
+    {
+        PARAMETERS_STAT_ADD(moudule, failures, 1);
+        printf("Parameters 0X%x erase sector:%d failed!\n", (uintptr_t)moudule, sector);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @description:                                Read the header of a journal sector
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} sector         index of sector
+ * @param       {PARAMETERS_JOURNAL_SECTOR_T} *header
+ * @return      {*}                             true if the sector belongs to this table
+ * @note       :
+ */
+static bool Parameters_Journal_Header(PARAMETERS_CB_T *moudule, unsigned short sector, PARAMETERS_JOURNAL_SECTOR_T *header)
+{
+    if (!Parameters_ROM(moudule, 2, (unsigned char *)header, Parameters_Journal_Offset(moudule, sector),
+                        sizeof(PARAMETERS_JOURNAL_SECTOR_T)))
+    {
+        return false;
+    }
+
+    return header->sequence != 0xFFFFFFFF &&
+           strncmp(header->table_tag, moudule->table_info.table_tag, 16) == 0 &&
+           header->check == Parameters_Checkout(moudule, (unsigned char *)header, offsetof(PARAMETERS_JOURNAL_SECTOR_T, check));
+}
+
+/**
+ * @description:                                Start writing records into a journal sector
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} sector         index of sector
+ * @return      {*}                             success or fail
+ * @note       :                                The sector becomes the head with the next sequence number
+ */
+static bool Parameters_Journal_Open(PARAMETERS_CB_T *moudule, unsigned short sector)
+{
+    PARAMETERS_JOURNAL_SECTOR_T header;
+    unsigned char *byte = (unsigned char *)&header;
+    unsigned char count;
+
+    // a header torn by power loss leaves the sector neither valid nor erased
+    if (!Parameters_ROM(moudule, 2, byte, Parameters_Journal_Offset(moudule, sector), sizeof(header)))
+    {
+        return false;
+    }
+    for (count = 0; count < sizeof(header); count++)
+    {
+        if (byte[count] != PARAMETERS_JOURNAL_ERASED)
+        {
+            if (!Parameters_Journal_Erase(moudule, sector))
+            {
+                return false;
+            }
+            break;
+        }
+    }
+
+    memcpy(header.table_tag, moudule->table_info.table_tag, 16);
+    header.sequence = moudule->journal_sequence + 1;
+    header.check = Parameters_Checkout(moudule, (unsigned char *)&header, offsetof(PARAMETERS_JOURNAL_SECTOR_T, check));
+    if (!Parameters_ROM(moudule, 1, (unsigned char *)&header, Parameters_Journal_Offset(moudule, sector), sizeof(header)))
+    {
+        printf("Parameters 0X%x open sector:%d failed!\n", (uintptr_t)moudule, sector);
+        return false;
+    }
+
+    moudule->journal_sequence = header.sequence;
+    moudule->journal_head = sector;
+    moudule->journal_slot = 0;
+    return true;
+}
+
+/**
+ * @description:                                Append a record to the head sector
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} op              PARAMETERS_JOURNAL_SET or PARAMETERS_JOURNAL_DEL
+ * @param       {PARAMETERS_CELL_T} *cell       content of the record
+ * @return      {*}                             success or fail
+ * @note       :                                The head sector must have a free slot
+ */
+static bool Parameters_Journal_Write(PARAMETERS_CB_T *moudule, unsigned char op, PARAMETERS_CELL_T *cell)
+{
+    PARAMETERS_JOURNAL_RECORD_T record;
+    unsigned int offset = Parameters_Journal_Offset(moudule, moudule->journal_head) + sizeof(PARAMETERS_JOURNAL_SECTOR_T) +
+                          moudule->journal_slot * sizeof(PARAMETERS_JOURNAL_RECORD_T);
+    unsigned char max_retry = 4;
+
+    record.op = op;
+    memcpy(&record.cell, cell, sizeof(PARAMETERS_CELL_T));
+    record.check = Parameters_Checkout(moudule, (unsigned char *)&record, offsetof(PARAMETERS_JOURNAL_RECORD_T, check));
+
+    // a failed program leaves the slot dirty, the retry goes to the next one
+    while (max_retry && moudule->journal_slot < Parameters_Journal_Slots(moudule))
+    {
+        moudule->journal_slot++;
+        if (Parameters_ROM(moudule, 1, (unsigned char *)&record, offset, sizeof(PARAMETERS_JOURNAL_RECORD_T)))
+        {
+            return true;
+        }
+        offset += sizeof(PARAMETERS_JOURNAL_RECORD_T);
+        max_retry--;
+        PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
+    }
+
+    PARAMETERS_STAT_ADD(moudule, failures, 1);
+    printf("Parameters 0X%x journal write failed!\n", (uintptr_t)moudule);
+    return false;
+}
+
+/**
+ * @description:                                Free the oldest journal sector
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} sector         index of the sector following the head
+ * @return      {*}                             success or fail
+ * @note       :                                Cells whose latest record is in the sector are copied to the head first,
+ *                                              so one erased sector is always ready when the head fills up
+ */
+static bool Parameters_Journal_Collect(PARAMETERS_CB_T *moudule, unsigned short sector)
+{
+    PARAMETERS_JOURNAL_SECTOR_T header;
+    unsigned short index;
+
+    if (!Parameters_Journal_Header(moudule, sector, &header))
+    {
+        // erased, or garbage that Parameters_Journal_Open will erase
+        return true;
+    }
+
+    for (index = 0; index < moudule->table_info.used_number; index++)
+    {
+        if (moudule->config.journal_map[index] == sector)
+        {
+            if (moudule->journal_slot >= Parameters_Journal_Slots(moudule) ||
+                !Parameters_Journal_Write(moudule, PARAMETERS_JOURNAL_SET, Parameters_Cell(moudule, index)))
+            {
+                printf("Parameters 0X%x journal without space\n", (uintptr_t)moudule);
+                return false;
+            }
+            moudule->config.journal_map[index] = moudule->journal_head;
+        }
+    }
+
+    return Parameters_Journal_Erase(moudule, sector);
+}
+
+/**
+ * @description:                                Append a record to the journal
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} op              PARAMETERS_JOURNAL_SET or PARAMETERS_JOURNAL_DEL
+ * @param       {unsigned short} index          index of the cell in RAM for PARAMETERS_JOURNAL_SET
+ * @param       {char} *name                    identifier of the deleted cell for PARAMETERS_JOURNAL_DEL
+ * @return      {*}                             success or fail
+ * @note       :                                Moves to the next sector and compacts the oldest one when the head is full
+ */
+static bool Parameters_Journal_Append(PARAMETERS_CB_T *moudule, unsigned char op, unsigned short index, char *name)
+{
+    PARAMETERS_CELL_T cell;
+    unsigned short sectors = moudule->config.journal_size / moudule->config.journal_sector;
+
+    if (moudule->journal_slot >= Parameters_Journal_Slots(moudule))
+    {
+        if (!Parameters_Journal_Open(moudule, (moudule->journal_head + 1) % sectors) ||
+            !Parameters_Journal_Collect(moudule, (moudule->journal_head + 1) % sectors) ||
+            moudule->journal_slot >= Parameters_Journal_Slots(moudule))
+        {
+            return false;
+        }
+    }
+
+    if (op == PARAMETERS_JOURNAL_SET)
+    {
+        moudule->config.journal_map[index] = moudule->journal_head;
+        return Parameters_Journal_Write(moudule, op, Parameters_Cell(moudule, index));
+    }
+
+    memset(&cell, EMPTY_BYTE, sizeof(cell));
+    strncpy(cell.name, name, 16);
+    return Parameters_Journal_Write(moudule, op, &cell);
+}
+
+/**
+ * @description:                                Apply one record of the journal to RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_JOURNAL_RECORD_T} *record
+ * @param       {unsigned short} sector         index of the sector holding the record
+ * @return      {*}
+ * @note       :
+ */
+static void Parameters_Journal_Replay(PARAMETERS_CB_T *moudule, PARAMETERS_JOURNAL_RECORD_T *record, unsigned short sector)
+{
+    PARAMETERS_CELL_T *cell;
+    char name[17];
+    unsigned short index;
+
+    memcpy(name, record->cell.name, 16);
+    name[16] = '\0';
+    if (name[0] == EMPTY_BYTE || !Parameters_Search(moudule, name, &index))
+    {
+        return;
+    }
+
+    cell = Parameters_Cell(moudule, index);
+    if (record->op == PARAMETERS_JOURNAL_DEL)
+    {
+        if (index < moudule->table_info.used_number)
+        {
+            Parameters_Cell_Remove(moudule, index);
+        }
+        return;
+    }
+
+    if (index < moudule->table_info.used_number)
+    {
+        Parameters_Check_Remove(moudule, index);
+        memcpy(cell, &record->cell, sizeof(PARAMETERS_CELL_T));
+    }
+    else
+    {
+        memcpy(cell, &record->cell, sizeof(PARAMETERS_CELL_T));
+        moudule->table_info.used_number++;
+        if (moudule->config.hash_block != NULL)
+        {
+            Parameters_Hash_Insert(moudule, index);
+        }
+        Parameters_Name_Set(moudule, index);
+        Parameters_Sort_Insert(moudule, index);
+    }
+    moudule->config.journal_map[index] = sector;
+    Parameters_Check_Add(moudule, index);
+}
+
+/**
+ * @description:                                Rebuild the table in RAM from the journal
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             success or fail
+ * @note       :                                The journal region is a ring of sectors, each starting with a header holding
+ *                                              an increasing sequence number and followed by fixed size records.
+ *                                              Sectors are replayed from the oldest, the newest is the head.
+ */
+static bool Parameters_Journal_Load(PARAMETERS_CB_T *moudule)
+{
+    PARAMETERS_JOURNAL_SECTOR_T header;
+    PARAMETERS_JOURNAL_RECORD_T record;
+    unsigned short sectors = moudule->config.journal_size / moudule->config.journal_sector;
+    unsigned short slots = Parameters_Journal_Slots(moudule);
+    unsigned short oldest = sectors;
+    unsigned int oldest_sequence = 0xFFFFFFFF;
+    unsigned short sector, count, slot;
+    unsigned int offset;
+
+    moudule->journal_sequence = 0;
+    for (sector = 0; sector < sectors; sector++)
+    {
+        if (Parameters_Journal_Header(moudule, sector, &header) && header.sequence < oldest_sequence)
+        {
+            oldest_sequence = header.sequence;
+            oldest = sector;
+        }
+    }
+
+    if (oldest == sectors)
+    {
+        // This is a whole new journal
+        return Parameters_Journal_Open(moudule, 0) && Parameters_Journal_Collect(moudule, 1);
+    }
+
+    for (count = 0; count < sectors; count++)
+    {
+        sector = (oldest + count) % sectors;
+        if (!Parameters_Journal_Header(moudule, sector, &header) || header.sequence < moudule->journal_sequence)
+        {
+            continue;
+        }
+        moudule->journal_sequence = header.sequence;
+        moudule->journal_head = sector;
+
+        offset = Parameters_Journal_Offset(moudule, sector) + sizeof(PARAMETERS_JOURNAL_SECTOR_T);
+        for (slot = 0; slot < slots; slot++)
+        {
+            if (!Parameters_ROM(moudule, 2, (unsigned char *)&record, offset, sizeof(record)))
+            {
+                printf("Parameters 0X%x journal read failed!\n", (uintptr_t)moudule);
+                return false;
+            }
+            if (record.op == PARAMETERS_JOURNAL_ERASED)
+            {
+                break;
+            }
+            // records torn by power loss are skipped
+            if (record.check == Parameters_Checkout(moudule, (unsigned char *)&record, offsetof(PARAMETERS_JOURNAL_RECORD_T, check)))
+            {
+                Parameters_Journal_Replay(moudule, &record, sector);
+            }
+            offset += sizeof(record);
+        }
+        moudule->journal_slot = slot;
+    }
+
+    // finish a compaction interrupted by power loss
+    return Parameters_Journal_Collect(moudule, (moudule->journal_head + 1) % sectors);
+}
+
+/**
+ * @description:                                Refresh the check value and write a changed cell and the table information to ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of the changed cell
+ * @return      {*}                             success or fail
+ * @note       :                                The old content of the cell must have been taken out by Parameters_Check_Remove
+ */
+static bool Parameters_Cell_Commit(PARAMETERS_CB_T *moudule, unsigned short index)
+{
+    bool status;
+
+    Parameters_Check_Add(moudule, index);
+
+    if (moudule->config.journal_size != 0)
+    {
+        return Parameters_Journal_Append(moudule, PARAMETERS_JOURNAL_SET, index, NULL);
+    }
+
+    if (Parameters_Batch_Mark(moudule, index, 1))
+    {
+        return true;
+    }
+
+    status = Parameters_Cell_SYNC(moudule, index, 1, 4);
+    if (moudule->config.lazy_page != 0)
+    {
+        status &= Parameters_Page_SYNC(moudule, index / moudule->config.lazy_page, 1, 1);
+    }
+    status &= Parameters_Info_SYNC(moudule, 1, 4);
+    return status;
+}
+
+/**
+ * @description:                                Index the packed cells in RAM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} number         number of cells
+ * @return      {*}                             false if the cells do not parse as the packed format
+ * @note       :
+ */
+static bool Parameters_Packed_Index(PARAMETERS_CB_T *moudule, unsigned short number)
+{
+    unsigned int offset = 0;
+    unsigned short index;
+    unsigned char width;
+
+    if (number >= Parameters_Offset_Count(moudule->block_size))
+    {
+        return false;
+    }
+
+    for (index = 0; index < number; index++)
+    {
+        moudule->config.offset_map[index] = offset;
+        if (offset + PARAMETERS_CELL_HEAD > moudule->block_size)
+        {
+            return false;
+        }
+        width = Parameters_Type_Width(Parameters_Cell(moudule, index)->type);
+        offset += PARAMETERS_CELL_HEAD + width;
+        if (width == 0 || offset > moudule->block_size)
+        {
+            return false;
+        }
+    }
+    moudule->config.offset_map[number] = offset;
+    return true;
+}
+
+/**
+ * @description:                                Load the cells of the packed format
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             success or fail
+ * @note       :                                A table of fixed size cells is converted and written back once
+ */
+static bool Parameters_Packed_Load(PARAMETERS_CB_T *moudule)
+{
+    unsigned short number = moudule->table_info.used_number;
+    unsigned int length = number * (PARAMETERS_CELL_HEAD + 8);
+    unsigned int offset = 0;
+    unsigned int chunk;
+    unsigned short index;
+    unsigned short *offset_map = moudule->config.offset_map;
+    bool status;
+
+    // the cells are no longer than the widest ones, read that much
+    length = length < moudule->block_size ? length : moudule->block_size;
+    while (offset < length)
+    {
+        chunk = moudule->config.max_transfer != 0 && moudule->config.max_transfer < length - offset ? moudule->config.max_transfer
+                                                                                                     : length - offset;
+        if (!Parameters_Bytes_SYNC(moudule, offset, chunk, 2, 4))
+        {
+            printf("Parameters 0X%x SYNC cell:%d-%d failed! type %d\n", (uintptr_t)moudule, 0, number - 1, 2);
+            return false;
+        }
+        offset += chunk;
+    }
+
+    if (Parameters_Packed_Index(moudule, number) &&
+        Parameters_Check_Table(moudule, number) == moudule->table_info.check_value)
+    {
+        offset = offset_map[number];
+        memset(moudule->block_start + offset, EMPTY_BYTE, moudule->block_size - offset);
+        return true;
+    }
+
+    // a table written with fixed size cells
+    moudule->config.offset_map = NULL;
+    status = number * sizeof(PARAMETERS_CELL_T) <= moudule->block_size &&
+             Parameters_Check_Table(moudule, number) == moudule->table_info.check_value;
+    moudule->config.offset_map = offset_map;
+    if (!status)
+    {
+        printf("Parameters 0X%x checkout error!\n", (uintptr_t)moudule);
+        memset(moudule->block_start, EMPTY_BYTE, moudule->block_size);
+        moudule->table_info.used_number = 0;
+        return false;
+    }
+
+    // the cells only shrink, moving them down in order never overwrites one not yet moved
+    offset = 0;
+    for (index = 0; index < number; index++)
+    {
+        chunk = Parameters_Type_Width(moudule->block_start[index * sizeof(PARAMETERS_CELL_T) + 16]);
+        if (chunk == 0 || chunk > 4)
+        {
+            printf("Parameters 0X%x checkout error!\n", (uintptr_t)moudule);
+            return false;
+        }
+        memmove(moudule->block_start + offset, moudule->block_start + index * sizeof(PARAMETERS_CELL_T), PARAMETERS_CELL_HEAD + chunk);
+        offset_map[index] = offset;
+        offset += PARAMETERS_CELL_HEAD + chunk;
+    }
+    offset_map[number] = offset;
+    memset(moudule->block_start + offset, EMPTY_BYTE, moudule->block_size - offset);
+
+    moudule->table_info.check_value = Parameters_Check_Table(moudule, number);
+    return (number == 0 || Parameters_Range_SYNC(moudule, 0, number, 1, 4)) && Parameters_Info_SYNC(moudule, 1, 4);
+}
+
+/**
+ * @description:                                ROM offset of the head of a bank
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} bank            0 or 1
+ * @return      {*}
+ * @note       :                                The table information and the cells follow the head
+ */
+static unsigned int Parameters_Bank_Offset(PARAMETERS_CB_T *moudule, unsigned char bank)
+{
+    return moudule->bank_ROM + bank * (sizeof(PARAMETERS_BANK_T) + sizeof(PARAMETERS_TABLE_INFO_T) + moudule->block_size);
+}
+
+/**
+ * @description:                                Read the head of a bank
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} bank            0 or 1
+ * @param       {PARAMETERS_BANK_T} *head
+ * @return      {*}                             true if the bank holds a complete image
+ * @note       :
+ */
+static bool Parameters_Bank_Read(PARAMETERS_CB_T *moudule, unsigned char bank, PARAMETERS_BANK_T *head)
+{
+    return Parameters_ROM(moudule, 2, (unsigned char *)head, Parameters_Bank_Offset(moudule, bank), sizeof(PARAMETERS_BANK_T)) &&
+           head->magic == PARAMETERS_BANK_MAGIC &&
+           head->check == Parameters_Checkout(moudule, (unsigned char *)head, offsetof(PARAMETERS_BANK_T, check));
+}
+
+/**
+ * @description:                                Point the table at the bank written last
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}
+ * @note       :                                The head is written after the image, a bank torn by a reset keeps the
+ *                                              head of its previous image and loses to the other one.
+ *                                              A region without a valid head is used from bank 0.
+ */
+static void Parameters_Bank_Select(PARAMETERS_CB_T *moudule)
+{
+    PARAMETERS_BANK_T head[2];
+    bool valid[2];
+
+    valid[0] = Parameters_Bank_Read(moudule, 0, &head[0]);
+    valid[1] = Parameters_Bank_Read(moudule, 1, &head[1]);
+
+    moudule->bank = valid[1] && (!valid[0] || (int)(head[1].sequence - head[0].sequence) > 0);
+    moudule->bank_sequence = valid[moudule->bank] ? head[moudule->bank].sequence : 0;
+    moudule->ROM_start_offset = Parameters_Bank_Offset(moudule, moudule->bank) + sizeof(PARAMETERS_BANK_T);
+}
+
+/**
+ * @description:                                Write the table to the inactive bank and make it the active one
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             success or fail, the active bank is unchanged on failure
+ * @note       :                                The cells go out with one Write_2_ROM call, then the table information,
+ *                                              the head last. check_value must be up to date.
+ */
+static bool Parameters_Bank_Switch(PARAMETERS_CB_T *moudule)
+{
+    PARAMETERS_BANK_T head;
+    unsigned int active = moudule->ROM_start_offset;
+    unsigned int offset = Parameters_Bank_Offset(moudule, !moudule->bank);
+    unsigned char max_retry = 4;
+    bool status = true;
+
+    if (moudule->config.Erase_ROM != NULL)
+    {
+        while (max_retry && !moudule->config.Erase_ROM(offset, Parameters_Bank_Offset(moudule, 1) - moudule->bank_ROM))
+        {
+            max_retry--;
+            PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
+        }
+        if (max_retry == 0)
+        {
+            PARAMETERS_STAT_ADD(moudule, failures, 1);
+            printf("Parameters 0X%x erase bank:%d failed!\n", (uintptr_t)moudule, !moudule->bank);
+            return false;
+        }
+    }
+
+    moudule->ROM_start_offset = offset + sizeof(PARAMETERS_BANK_T);
+    if (moudule->table_info.used_number != 0)
+    {
+        status = Parameters_Range_SYNC(moudule, 0, moudule->table_info.used_number, 1, 4);
+    }
+    status = status && Parameters_Info_SYNC(moudule, 1, 4);
+
+    head.magic = PARAMETERS_BANK_MAGIC;
+    head.sequence = moudule->bank_sequence + 1;
+    head.check = Parameters_Checkout(moudule, (unsigned char *)&head, offsetof(PARAMETERS_BANK_T, check));
+    max_retry = 4;
+    while (status && !Parameters_ROM(moudule, 1, (unsigned char *)&head, offset, sizeof(PARAMETERS_BANK_T)))
+    {
+        max_retry--;
+        PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
+        if (max_retry == 0)
+        {
+            PARAMETERS_STAT_ADD(moudule, failures, 1);
+            status = false;
+        }
+    }
+    if (!status)
+    {
+        printf("Parameters 0X%x switch bank:%d failed!\n", (uintptr_t)moudule, !moudule->bank);
+        moudule->ROM_start_offset = active;
+        return false;
+    }
+
+    moudule->bank = !moudule->bank;
+    moudule->bank_sequence = head.sequence;
+    return true;
+}
+
+/**
+ * @description:                                Load the table of the active bank again
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             success or fail
+ * @note       :                                Drops the changes a failed Parameters_Bank_Switch did not write.
+ *                                              Handles become stale and deltas need a full resync. The caller
+ *                                              has called Parameters_Write_Begin.
+ */
+static bool Parameters_Bank_Reload(PARAMETERS_CB_T *moudule)
+{
+    bool status;
+
+    memset(moudule->block_start, EMPTY_BYTE, moudule->block_size);
+    status = Parameters_Info_SYNC(moudule, 2, 4);
+    if (status && moudule->config.offset_map != NULL)
+    {
+        status = Parameters_Packed_Load(moudule);
+    }
+    else if (status)
+    {
+        status = (moudule->table_info.used_number == 0 ||
+                  Parameters_Range_SYNC(moudule, 0, moudule->table_info.used_number, 2, 4)) &&
+                 Parameters_Check_Table(moudule, moudule->table_info.used_number) == moudule->table_info.check_value;
+        if (!status)
+        {
+            printf("Parameters 0X%x checkout error!\n", (uintptr_t)moudule);
+        }
+    }
+    Parameters_Free_Build(moudule);
+    Parameters_Hash_Build(moudule);
+    Parameters_Name_Build(moudule);
+    Parameters_Sort_Build(moudule);
+    moudule->change_floor = moudule->generation;
+    moudule->layout_version++;
+    if (moudule->layout_version == 0)
+    {
+        moudule->layout_version = 1;
+    }
+    return status;
+}
+
+/**
+ * @description:
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *table_tag               String identifier. Must end with '\0' and be no longer than 16
+ * @param       {unsigned char} *RAM_block      Address of a storage block allocated in RAM
+ * @param       {unsigned int} ROM_block        Offset address of a storage block allocated in ROM
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @param       {bool char} Read_From_ROM       Funtion of read data from ROM
+ * @param       {bool} Write_2_ROM              Funtion of write data to ROM
+ * @param       {PARAMETERS_CHECK_T} checkout   Funtion of data checkout
+ * @return      {*}                             success or fail
+ * @note       :
+ */
+bool Parameters_Init(PARAMETERS_CB_T *moudule, char *table_tag, unsigned char *RAM_block, unsigned int ROM_block, unsigned int size,
+                     bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
+                     bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
+                     PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int))
+{
+    return Parameters_Init_Ex(moudule, table_tag, RAM_block, ROM_block, size,
+                              Read_From_ROM, Write_2_ROM, checkout, NULL);
+}
+
+/**
+ * @description:                                Number of hash index slots suited to a RAM block
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @return      {*}                             Power of two, at least twice the number of cells
+ * @note       :                                The hash block passed in PARAMETERS_CONFIG_T needs this many unsigned short
+ */
+unsigned int Parameters_Hash_Slots(unsigned int size)
+{
+    unsigned int slots = 1;
+
+    while (slots < 2 * Parameters_Offset_Count(size))
+    {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+/**
+ * @description:                                Size of the dirty bitmap suited to a RAM block
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @return      {*}                             bytes of the bitmap, one bit per cell
+ * @note       :
+ */
+unsigned int Parameters_Dirty_Size(unsigned int size)
+{
+    return (Parameters_Offset_Count(size) + 7) / 8;
+}
+
+/**
+ * @description:                                Number of offsets of the packed cell format suited to a RAM block
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @return      {*}                             unsigned short entries of offset_map, one per cell of one byte values and one more
+ * @note       :
+ */
+unsigned int Parameters_Offset_Count(unsigned int size)
+{
+    return size / (PARAMETERS_CELL_HEAD + 1) + 1;
+}
+
+/**
+ * @description:                                Number of pages of the lazy loading mode
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @param       {unsigned short} lazy_page      cells per page
+ * @return      {*}                             PARAMETERS_CHECK_T page check values needed, the loaded bitmap needs (pages + 7) / 8 bytes
+ * @note       :
+ */
+unsigned short Parameters_Page_Count(unsigned int size, unsigned short lazy_page)
+{
+    if (lazy_page == 0)
+    {
+        return 0;
+    }
+    return (size / sizeof(PARAMETERS_CELL_T) + lazy_page - 1) / lazy_page;
+}
+
+/**
+ * @description:                                Fill a free cell with a new parameter
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          a tombstone to reuse or used_number
+ * @param       {PARAMETERS_WIDE_CELL_T} *temp  identifier, type and value of the cell
+ * @return      {*}
+ * @note       :                                The caller holds OS_LOCK, has checked that the value fits the cell
+ *                                              and has called Parameters_Write_Begin. Nothing is written to ROM.
+ */
+static void Parameters_Cell_Place(PARAMETERS_CB_T *moudule, unsigned short index, PARAMETERS_WIDE_CELL_T *temp)
+{
+    unsigned char width = Parameters_Type_Width(temp->type);
+
+    if (index < moudule->table_info.used_number)
+    {
+        // reuse a tombstone, handles to the deleted cell must not see the new one
+        Parameters_Check_Remove(moudule, index);
+        moudule->free_cached--;
+        moudule->free_number--;
+        moudule->layout_version++;
+        if (moudule->layout_version == 0)
+        {
+            moudule->layout_version = 1;
+        }
+    }
+    else
+    {
+        moudule->table_info.used_number++;
+        if (moudule->config.offset_map != NULL)
+        {
+            moudule->config.offset_map[index + 1] = moudule->config.offset_map[index] + PARAMETERS_CELL_HEAD + width;
+        }
+    }
+    memcpy(Parameters_Cell(moudule, index), temp,
+           moudule->config.offset_map != NULL ? PARAMETERS_CELL_HEAD + width : sizeof(PARAMETERS_CELL_T));
+    moudule->index_map_valid = false;
+    if (moudule->config.hash_block != NULL)
+    {
+        Parameters_Hash_Insert(moudule, index);
+    }
+    Parameters_Name_Set(moudule, index);
+    Parameters_Sort_Insert(moudule, index);
+}
+
+/**
+ * @description:                                Bytes of ROM a table takes from its ROM_block
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @param       {PARAMETERS_CONFIG_T} *config   Optional features, NULL for a table of Parameters_Init
+ * @return      {*}                             table information, cells and page check values, the journal or both banks
+ * @note       :
+ */
+unsigned int Parameters_ROM_Size(unsigned int size, const PARAMETERS_CONFIG_T *config)
+{
+    if (config != NULL && config->journal_size != 0)
+    {
+        return config->journal_size;
+    }
+    if (config != NULL && config->lazy_page != 0)
+    {
+        return sizeof(PARAMETERS_TABLE_INFO_T) + (size / sizeof(PARAMETERS_CELL_T)) * sizeof(PARAMETERS_CELL_T) +
+               Parameters_Page_Count(size, config->lazy_page) * sizeof(PARAMETERS_CHECK_T);
+    }
+    if (config != NULL && config->banks)
+    {
+        return 2 * (sizeof(PARAMETERS_BANK_T) + sizeof(PARAMETERS_TABLE_INFO_T) + size);
+    }
+    return sizeof(PARAMETERS_TABLE_INFO_T) + size;
+}
+
+/**
+ * @description:                                Bytes of the RAM block taken by the cells of a table
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             bytes up to the end of the last cell, tombstones included
+ * @note       :                                A table initialized with a larger size than this holds the same cells
+ */
+unsigned int Parameters_Used_Size(PARAMETERS_CB_T *moudule)
+{
+    return Parameters_Cell_Offset(moudule, moudule->table_info.used_number);
+}
+
+/**
+ * @description:                                Initialize the module with optional features
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *table_tag               String identifier. Must end with '\0' and be no longer than 16
+ * @param       {unsigned char} *RAM_block      Address of a storage block allocated in RAM
+ * @param       {unsigned int} ROM_block        Offset address of a storage block allocated in ROM
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @param       {bool char} Read_From_ROM       Funtion of read data from ROM
+ * @param       {bool} Write_2_ROM              Funtion of write data to ROM
+ * @param       {PARAMETERS_CHECK_T} checkout   Funtion of data checkout
+ * @param       {PARAMETERS_CONFIG_T} *config   Optional features, NULL behaves as Parameters_Init
+ * @return      {*}                             success or fail
+ * @note       :
+ */
+bool Parameters_Init_Ex(PARAMETERS_CB_T *moudule, char *table_tag, unsigned char *RAM_block, unsigned int ROM_block, unsigned int size,
+                        bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
+                        bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
+                        PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int),
+                        const PARAMETERS_CONFIG_T *config)
+{
+    bool status = true;
+    unsigned short index = 0;
+    unsigned short chunk, number;
+
+    moudule->block_start = RAM_block;
+    moudule->ROM_start_offset = ROM_block;
+    moudule->block_size = size;
+
+    // handles taken before a re-initialization are stale
+    moudule->layout_version++;
+    if (moudule->layout_version == 0)
+    {
+        moudule->layout_version = 1;
+    }
+
+    if (config != NULL)
+    {
+        moudule->config = *config;
+    }
+    else
+    {
+        memset(&moudule->config, 0, sizeof(PARAMETERS_CONFIG_T));
+    }
+
+    moudule->batch_depth = 0;
+    moudule->batch_pending = 0;
+    moudule->saved_writes = 0;
+    moudule->free_number = 0;
+    moudule->free_cached = 0;
+    moudule->index_map_valid = false;
+    moudule->sequence = 0;
+    if (moudule->config.dirty_block != NULL)
+    {
+        memset(moudule->config.dirty_block, 0, Parameters_Dirty_Size(size));
+    }
+
+    if (moudule->config.hash_block != NULL &&
+        ((moudule->config.hash_size & (moudule->config.hash_size - 1)) != 0 ||
+         moudule->config.hash_size <= (moudule->config.offset_map != NULL ? Parameters_Offset_Count(size)
+                                                                          : size / sizeof(PARAMETERS_CELL_T))))
+    {
+        printf("Parameters 0X%x hash size error!\n", (uintptr_t)moudule);
+        return false;
+    }
+
+    if (moudule->config.journal_size != 0 &&
+        (moudule->config.journal_map == NULL || moudule->config.tombstone ||
+         moudule->config.journal_sector < sizeof(PARAMETERS_JOURNAL_SECTOR_T) + sizeof(PARAMETERS_JOURNAL_RECORD_T) ||
+         moudule->config.journal_size / moudule->config.journal_sector < 2 ||
+         moudule->config.journal_size / moudule->config.journal_sector > 255))
+    {
+        printf("Parameters 0X%x journal size error!\n", (uintptr_t)moudule);
+        return false;
+    }
+
+    if (moudule->config.lazy_page != 0)
+    {
+        if (moudule->config.page_check == NULL || moudule->config.page_loaded == NULL ||
+            moudule->config.journal_size != 0 || moudule->config.tombstone || moudule->config.seqlock)
+        {
+            printf("Parameters 0X%x lazy page error!\n", (uintptr_t)moudule);
+            return false;
+        }
+        memset(moudule->config.page_loaded, 0, (Parameters_Page_Number(moudule) + 7) / 8);
+    }
+    moudule->page_dirty = false;
+
+    if (moudule->config.name_block != NULL &&
+        (((uintptr_t)moudule->config.name_block & 15) != 0 || moudule->config.lazy_page != 0))
+    {
+        printf("Parameters 0X%x name block error!\n", (uintptr_t)moudule);
+        return false;
+    }
+
+    moudule->sort_number = 0;
+    if (moudule->config.sort_map != NULL && moudule->config.lazy_page != 0)
+    {
+        printf("Parameters 0X%x sort map error!\n", (uintptr_t)moudule);
+        return false;
+    }
+
+    if (moudule->config.offset_map != NULL)
+    {
+        if (size > 0xFFFF || moudule->config.journal_size != 0 || moudule->config.tombstone || moudule->config.lazy_page != 0)
+        {
+            printf("Parameters 0X%x packed cell error!\n", (uintptr_t)moudule);
+            return false;
+        }
+        moudule->config.offset_map[0] = 0;
+    }
+
+    if (moudule->config.async_ring != NULL &&
+        ((moudule->config.async_size & (moudule->config.async_size - 1)) != 0 ||
+         moudule->config.async_size < Parameters_Offset_Count(size) + 2 || moudule->config.dirty_block == NULL ||
+         moudule->config.journal_size != 0 || moudule->config.lazy_page != 0))
+    {
+        printf("Parameters 0X%x async ring error!\n", (uintptr_t)moudule);
+        return false;
+    }
+    if (moudule->config.banks &&
+        (moudule->config.journal_size != 0 || moudule->config.lazy_page != 0 || moudule->config.async_ring != NULL))
+    {
+        printf("Parameters 0X%x bank error!\n", (uintptr_t)moudule);
+        return false;
+    }
+    if (moudule->config.mapped &&
+        (moudule->config.journal_size != 0 || moudule->config.offset_map != NULL || moudule->config.lazy_page != 0 ||
+         moudule->config.banks))
+    {
+        printf("Parameters 0X%x mapped error!\n", (uintptr_t)moudule);
+        return false;
+    }
+    moudule->bank_ROM = ROM_block;
+    moudule->bank_sequence = 0;
+    moudule->bank = 0;
+
+    moudule->generation = 0;
+    moudule->change_head = 0;
+    moudule->change_floor = 0;
+    if (moudule->config.change_log != NULL && (moudule->config.change_size & (moudule->config.change_size - 1)) != 0)
+    {
+        printf("Parameters 0X%x change log size error!\n", (uintptr_t)moudule);
+        return false;
+    }
+    if (moudule->config.version_map != NULL)
+    {
+        memset(moudule->config.version_map, 0, Parameters_Offset_Count(size) * sizeof(unsigned int));
+    }
+    if (moudule->config.subscription_block != NULL)
+    {
+        memset(moudule->config.subscription_block, 0, moudule->config.subscription_size * sizeof(PARAMETERS_SUBSCRIPTION_T));
+    }
+
+    moudule->async_head = 0;
+    moudule->async_tail = 0;
+    moudule->async_durable = 0;
+    moudule->async_info = 0;
+    moudule->async_worker = NULL;
+    moudule->Async_Notify = NULL;
+    moudule->Async_Wait = NULL;
+#if PARAMETERS_STATS
+    memset(&moudule->stats, 0, sizeof(PARAMETERS_STATS_T));
+#endif
+
+    if (!moudule->config.mapped)
+    {
+        memset(moudule->block_start, EMPTY_BYTE, moudule->block_size);
+    }
+
+    moudule->Read_From_ROM = Read_From_ROM;
+    moudule->Write_2_ROM = Write_2_ROM;
+    moudule->checkout = checkout;
+
+    if (moudule->config.journal_size != 0)
+    {
+        memset(moudule->table_info.table_tag, EMPTY_BYTE, 16);
+        strncpy(moudule->table_info.table_tag, table_tag, 16);
+        moudule->table_info.used_number = 0;
+        moudule->table_info.check_value = Parameters_Check_Table(moudule, 0);
+        if (moudule->config.hash_block != NULL)
+        {
+            memset(moudule->config.hash_block, 0, moudule->config.hash_size * sizeof(unsigned short));
+        }
+        return Parameters_Journal_Load(moudule);
+    }
+
+    if (moudule->config.banks)
+    {
+        Parameters_Bank_Select(moudule);
+    }
+
+    // load table info
+    status = Parameters_Info_SYNC(moudule, 2, 4);
+
+    if (status)
+    {
+        if (!strcmp(moudule->table_info.table_tag, table_tag) == 0)
+        {
+            // This is a whole new memory area that needs to write new information
+            memset(moudule->table_info.table_tag, EMPTY_BYTE, 16);
+            strcpy(moudule->table_info.table_tag, table_tag);
+            moudule->table_info.used_number = 0;
+            moudule->table_info.check_value = Parameters_Check_Table(moudule, 0);
+            if (moudule->config.mapped)
+            {
+                memset(moudule->block_start, EMPTY_BYTE, moudule->block_size);
+            }
+            if (moudule->config.lazy_page != 0)
+            {
+                Parameters_Page_Refresh(moudule, 0, Parameters_Page_Number(moudule));
+                status = Parameters_Page_SYNC(moudule, 0, Parameters_Page_Number(moudule), 1);
+            }
+
+            status = status && Parameters_Info_SYNC(moudule, 1, 4);
+        }
+    }
+
+    if (status && moudule->config.offset_map != NULL)
+    {
+        status = Parameters_Packed_Load(moudule);
+        Parameters_Hash_Build(moudule);
+        Parameters_Name_Build(moudule);
+        Parameters_Sort_Build(moudule);
+        return status;
+    }
+
+    if (status && moudule->config.lazy_page != 0)
+    {
+        // the page check values stand in for the cells until a page is touched
+        if (Parameters_Page_SYNC(moudule, 0, Parameters_Page_Number(moudule), 2) &&
+            Parameters_Checkout(moudule, (unsigned char *)moudule->config.page_check,
+                              Parameters_Page_Number(moudule) * sizeof(PARAMETERS_CHECK_T)) == moudule->table_info.check_value)
+        {
+            if (moudule->config.hash_block != NULL)
+            {
+                memset(moudule->config.hash_block, 0, moudule->config.hash_size * sizeof(unsigned short));
+            }
+            return true;
+        }
+    }
+
+    if (status && moudule->config.mapped)
+    {
+        // the cells are in RAM already, only the space after them is cleared
+        index = moudule->table_info.used_number;
+        status = Parameters_Cell_Offset(moudule, index) < moudule->block_size;
+        if (status)
+        {
+            memset(moudule->block_start + Parameters_Cell_Offset(moudule, index), EMPTY_BYTE,
+                   moudule->block_size - Parameters_Cell_Offset(moudule, index));
+        }
+        else
+        {
+            memset(moudule->block_start, EMPTY_BYTE, moudule->block_size);
+            index = 0;
+        }
+    }
+    else if (status)
+    {
+        // load ROM to RAM in as few reads as the transfer size allows
+        chunk = moudule->table_info.used_number;
+        if (moudule->config.max_transfer != 0 && moudule->config.max_transfer / sizeof(PARAMETERS_CELL_T) < chunk)
+        {
+            chunk = moudule->config.max_transfer / sizeof(PARAMETERS_CELL_T);
+            chunk = chunk == 0 ? 1 : chunk;
+        }
+
+        while (status && index < moudule->table_info.used_number)
+        {
+            number = moudule->table_info.used_number - index < chunk ? moudule->table_info.used_number - index : chunk;
+            if (Parameters_Range_SYNC(moudule, index, number, 2, 1))
+            {
+                index += number;
+                continue;
+            }
+
+            // fall back to reading the failed chunk cell by cell
+            while (number)
+            {
+                status = Parameters_Cell_SYNC(moudule, index, 2, 4);
+                if (status)
+                {
+                    index++;
+                    number--;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (status)
+    {
+        // checkout
+        if (!(Parameters_Check_Table(moudule, index) == moudule->table_info.check_value))
+        {
+            printf("Parameters 0X%x checkout error!\n", (uintptr_t)moudule);
+            status = false;
+        }
+    }
+
+    if (status && moudule->config.lazy_page != 0)
+    {
+        // a table written without page check values, build them once
+        Parameters_Page_Refresh(moudule, 0, Parameters_Page_Number(moudule));
+        memset(moudule->config.page_loaded, 0xFF, (Parameters_Page_Number(moudule) + 7) / 8);
+        status = Parameters_Page_SYNC(moudule, 0, Parameters_Page_Number(moudule), 1) && Parameters_Info_SYNC(moudule, 1, 4);
+    }
+
+    Parameters_Free_Build(moudule);
+    Parameters_Hash_Build(moudule);
+    Parameters_Name_Build(moudule);
+    Parameters_Sort_Build(moudule);
+
+    return status;
+}
+
+/**
+ * @description:                                Create a storage cell based on the parameter identifier and fill it with the default value,
+ *                                              returning the current stored value if the parameter already exists.
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {PARAMETERS_TYPE_T} type
+ * @param       {void} *default_value           Address default value.
+ * @return      {*}                             Address of value.
+ * @note       :                                If no identifier is found and there is no space left to create a cell, NULL is returned.
+ */
+void *Parameters_Creat(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *default_value)
+{
+    PARAMETERS_CELL_T *cell = NULL;
+    PARAMETERS_WIDE_CELL_T temp;
+    void *ret = NULL;
+    unsigned short index;
+    bool status;
+
+    OS_LOCK();
+
+    status = Parameters_Search(moudule, name, &index);
+    // not found, reuse a deleted cell before growing the table
+    if ((!status || Parameters_Cell(moudule, index)->name[0] == EMPTY_BYTE) && Parameters_Free_Peek(moudule, &index))
+    {
+        status = true;
+    }
+
+    if (status)
+    {
+        cell = Parameters_Cell(moudule, index);
+        ret = cell->data;
+        if (cell->name[0] == EMPTY_BYTE)
+        {
+            memset(&temp, EMPTY_BYTE, sizeof(temp));
+            strncpy(temp.name, name, 16);
+            temp.type = type;
+
+            if ((moudule->config.offset_map == NULL && Parameters_Type_Width(type) > sizeof(cell->data)) ||
+                !Parameters_Load_value(temp.data, default_value, type))
+            {
+                printf("Parameters %s type error\n", name);
+            }
+            else if (moudule->config.offset_map != NULL && index == moudule->table_info.used_number &&
+                     moudule->config.offset_map[index] + PARAMETERS_CELL_HEAD + Parameters_Type_Width(type) > moudule->block_size)
+            {
+                printf("Parameters 0X%x without space\n", (uintptr_t)moudule);
+                ret = NULL;
+            }
+            else
+            {
+                Parameters_Write_Begin(moudule);
+                Parameters_Cell_Place(moudule, index, &temp);
+                Parameters_Write_End(moudule);
+                Parameters_Changed(moudule, index, cell->name);
+
+                Parameters_Cell_Commit(moudule, index);
+            }
+        }
+    }
+    else
+    {
+        printf("Parameters 0X%x without space\n", (uintptr_t)moudule);
+    }
+
+    OS_UNLOCK();
+    return ret;
+}
+
+/**
+ * @description:                                Change the value of the parameter
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {void} *value                   Address of value.
+ * @return      {*}                             Address of value.
+ * @note       :                                If the corresponding identifier is not found, NULL is returned.
+ */
+void *Parameters_Chanege(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *value)
+{
+    PARAMETERS_CELL_T *cell = NULL;
+    void *ret = NULL;
+    unsigned short index;
+    bool status;
+
+    OS_LOCK();
+
+    if (Parameters_Search(moudule, name, &index))
+    {
+        cell = Parameters_Cell(moudule, index);
+        if (cell->name[0] != EMPTY_BYTE && cell->type == type)
+        {
+            ret = cell->data;
+            Parameters_Check_Remove(moudule, index);
+            Parameters_Write_Begin(moudule);
+            status = Parameters_Load_value(cell->data, value, cell->type);
+            Parameters_Write_End(moudule);
+            if (!status)
+            {
+                printf("Parameters %s type error\n", name);
+                Parameters_Check_Add(moudule, index);
+            }
+            else
+            {
+                Parameters_Changed(moudule, index, cell->name);
+                Parameters_Cell_Commit(moudule, index);
+            }
+        }
+    }
+
+    OS_UNLOCK();
+    return ret;
+}
+
+/**
+ * @description:                                Delete an existing parameter storage cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @return      {*}                             If the corresponding identifier is not found, false is returned.
+ * @note       :
+ */
+bool Parameters_Del(PARAMETERS_CB_T *moudule, char *name)
+{
+    bool status = false;
+    PARAMETERS_CELL_T *cell = NULL;
+    unsigned short index;
+
+    OS_LOCK();
+
+    if (Parameters_Search(moudule, name, &index))
+    {
+        cell = Parameters_Cell(moudule, index);
+        if (cell->name[0] != EMPTY_BYTE && moudule->config.tombstone)
+        {
+            Parameters_Check_Remove(moudule, index);
+            Parameters_Write_Begin(moudule);
+            if (moudule->config.hash_block != NULL)
+            {
+                Parameters_Hash_Remove(moudule, index);
+            }
+            Parameters_Sort_Remove(moudule, index);
+            memset(cell, EMPTY_BYTE, sizeof(PARAMETERS_CELL_T));
+            cell->type = PARAMETERS_TYPE_TOMBSTONE;
+            Parameters_Name_Set(moudule, index);
+
+            moudule->free_number++;
+            if (moudule->free_cached < PARAMETERS_FREE_CACHE)
+            {
+                moudule->free_cache[moudule->free_cached++] = index;
+            }
+            moudule->index_map_valid = false;
+            Parameters_Write_End(moudule);
+            Parameters_Changed(moudule, index, name);
+            moudule->change_floor = moudule->generation;
+
+            Parameters_Cell_Commit(moudule, index);
+            status = true;
+        }
+        else if (cell->name[0] != EMPTY_BYTE)
+        {
+            Parameters_Write_Begin(moudule);
+            Parameters_Cell_Remove(moudule, index);
+            Parameters_Write_End(moudule);
+            Parameters_Changed(moudule, PARAMETERS_NO_CELL, name);
+            moudule->change_floor = moudule->generation;
+
+            if (moudule->config.journal_size != 0)
+            {
+                Parameters_Journal_Append(moudule, PARAMETERS_JOURNAL_DEL, index, name);
+            }
+            else if (moudule->config.offset_map != NULL)
+            {
+                // the bytes freed at the end of a packed table are not read again, only moved cells are written
+                if (!Parameters_Batch_Mark(moudule, index, moudule->table_info.used_number - index))
+                {
+                    if (index < moudule->table_info.used_number)
+                    {
+                        Parameters_Range_SYNC(moudule, index, moudule->table_info.used_number - index, 1, 4);
+                    }
+                    Parameters_Info_SYNC(moudule, 1, 4);
+                }
+            }
+            else if (!Parameters_Batch_Mark(moudule, index, moudule->table_info.used_number + 1 - index))
+            {
+                if (moudule->config.lazy_page != 0)
+                {
+                    Parameters_Page_SYNC(moudule, index / moudule->config.lazy_page,
+                                         Parameters_Page_Number(moudule) - index / moudule->config.lazy_page, 1);
+                }
+                while (index <= moudule->table_info.used_number)
+                {
+                    Parameters_Cell_SYNC(moudule, index, 1, 4);
+                    index++;
+                }
+                Parameters_Info_SYNC(moudule, 1, 4);
+            }
+            status = true;
+        }
+    }
+
+    OS_UNLOCK();
+
+    return status;
+}
+
+/**
+ * @description:                                Read the parameter at an index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 if there is none
+ * @note       :                                Called between Parameters_Read_Begin and Parameters_Read_Retry
+ */
+static unsigned char Parameters_Index_Read(PARAMETERS_CB_T *moudule, unsigned short index, char *name, void *value)
+{
+    PARAMETERS_CELL_T *cell = NULL;
+    unsigned char type = 0;
+
+    if (index >= moudule->table_info.used_number - moudule->free_number)
+    {
+        return type;
+    }
+
+    // tombstones are skipped, indexes stay dense
+    if (moudule->free_number != 0)
+    {
+        index = Parameters_Index_Slot(moudule, index);
+    }
+    if (!Parameters_Page_Ensure(moudule, index))
+    {
+        return type;
+    }
+
+    cell = Parameters_Cell(moudule, index);
+
+    if (cell->name[0] != EMPTY_BYTE)
+    {
+        memcpy(name, cell->name, 16);
+        type = Parameters_Cell_Type(moudule, cell);
+        Parameters_Load_value(value, cell->data, type);
+    }
+    return type;
+}
+
+/**
+ * @description:                                Get the identifier of the parameter based on the index
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} index          index
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}
+ * @note       :
+ */
+unsigned char Parameters_Get_by_index(PARAMETERS_CB_T *moudule, unsigned short index, char *name, void *value)
+{
+    unsigned char type;
+    unsigned int sequence;
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        type = Parameters_Index_Read(moudule, index, name, value);
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return type;
+}
+
+/**
+ * @description:                                Read the first parameter at or after a cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} *slot          index of cell to start at, moved past the cell read
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 if there is none
+ * @note       :                                Called between Parameters_Read_Begin and Parameters_Read_Retry
+ */
+static unsigned char Parameters_Next_Read(PARAMETERS_CB_T *moudule, unsigned short *slot, char *name, void *value)
+{
+    PARAMETERS_CELL_T *cell = NULL;
+    unsigned char type = 0;
+
+    for (; *slot < moudule->table_info.used_number; (*slot)++)
+    {
+        if (!Parameters_Page_Ensure(moudule, *slot))
+        {
+            return type;
+        }
+        cell = Parameters_Cell(moudule, *slot);
+        if (cell->name[0] != EMPTY_BYTE)
+        {
+            memcpy(name, cell->name, 16);
+            type = Parameters_Cell_Type(moudule, cell);
+            Parameters_Load_value(value, cell->data, type);
+            (*slot)++;
+            break;
+        }
+    }
+    return type;
+}
+
+/**
+ * @description:                                Get the parameter at a cursor over the cells and move the cursor past it
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} *cursor        0 before the first call, then left as returned
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 when there is no more
+ * @note       :                                Parameters come in the order of Parameters_Get_by_index. Tombstones are
+ *                                              stepped over, so a walk of the table is O(n) without an index map.
+ */
+unsigned char Parameters_Get_Next(PARAMETERS_CB_T *moudule, unsigned short *cursor, char *name, void *value)
+{
+    unsigned char type;
+    unsigned int sequence;
+    unsigned short slot;
+
+    do
+    {
+        slot = *cursor;
+        sequence = Parameters_Read_Begin(moudule);
+        type = Parameters_Next_Read(moudule, &slot, name, value);
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    *cursor = slot;
+    return type;
+}
+
+/**
+ * @description:                                Read the parameter of an identifier
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {unsigned short} *index         index
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 if there is none
+ * @note       :                                Called between Parameters_Read_Begin and Parameters_Read_Retry
+ */
+static unsigned char Parameters_Name_Read(PARAMETERS_CB_T *moudule, char *name, unsigned short *index, void *value)
+{
+    PARAMETERS_CELL_T *cell = NULL;
+    unsigned char type = 0;
+    unsigned short slot;
+    unsigned short dense;
+
+    if (Parameters_Search(moudule, name, index))
+    {
+        cell = Parameters_Cell(moudule, *index);
+        if (cell->name[0] != EMPTY_BYTE)
+        {
+            type = Parameters_Cell_Type(moudule, cell);
+            Parameters_Load_value(value, cell->data, type);
+
+            // the index given by Parameters_Get_by_index does not count tombstones
+            if (moudule->free_number != 0)
+            {
+                dense = *index;
+                for (slot = 0; slot < *index; slot++)
+                {
+                    if (PARAMETERS_IS_TOMBSTONE(Parameters_Cell(moudule, slot)))
+                    {
+                        dense--;
+                    }
+                }
+                *index = dense;
+            }
+        }
+    }
+    return type;
+}
+
+/**
+ * @description:                                Get the index of the parameter based on the identifier
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {unsigned short} *index         index
+ * @param       {void} *value                   value of parameter
+ * @return      {*}
+ * @note       :
+ */
+unsigned char Parameters_Get_by_name(PARAMETERS_CB_T *moudule, char *name, unsigned short *index, void *value)
+{
+    unsigned char type;
+    unsigned int sequence;
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        type = Parameters_Name_Read(moudule, name, index, value);
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return type;
+}
+
+/**
+ * @description:                                Read the entry of the sorted index at a cursor if it is in a range
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} *first          lowest identifier padded with '\0' to 16 bytes
+ * @param       {unsigned char} length          bytes of first every identifier must start with, 0 for any
+ * @param       {unsigned char} *last           identifier padded to 16 bytes the range stops before, NULL for none
+ * @param       {unsigned short} *cursor        position in the sorted index, 0 to start at first
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 at the end of the range
+ * @note       :                                Called between Parameters_Read_Begin and Parameters_Read_Retry
+ */
+static unsigned char Parameters_Sort_Read(PARAMETERS_CB_T *moudule, const unsigned char *first, unsigned char length,
+                                          const unsigned char *last, unsigned short *cursor, char *name, void *value)
+{
+    PARAMETERS_CELL_T *cell = NULL;
+    unsigned char type = 0;
+    unsigned short position = *cursor;
+    unsigned short index;
+
+    if (moudule->config.sort_map == NULL)
+    {
+        return type;
+    }
+
+    // only the first call searches, the cursor then walks the matching entries
+    if (position == 0)
+    {
+        position = Parameters_Sort_Lower(moudule, first);
+    }
+    if (position >= moudule->sort_number)
+    {
+        return type;
+    }
+
+    index = moudule->config.sort_map[position];
+    if (!Parameters_Cell_Fits(moudule, index))
+    {
+        return type;
+    }
+    cell = Parameters_Cell(moudule, index);
+    if (cell->name[0] == EMPTY_BYTE || memcmp(cell->name, first, length) != 0 ||
+        (last != NULL && memcmp(cell->name, last, 16) >= 0))
+    {
+        return type;
+    }
+
+    memcpy(name, cell->name, 16);
+    type = Parameters_Cell_Type(moudule, cell);
+    Parameters_Load_value(value, cell->data, type);
+    *cursor = position + 1;
+    return type;
+}
+
+/**
+ * @description:                                Get the next parameter whose identifier starts with a prefix
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *prefix                  String the identifiers start with, "" for every parameter
+ * @param       {unsigned short} *cursor        0 before the first call, then left as returned
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 when there is no more
+ * @note       :                                Needs the sorted index. Parameters come in the order of their identifiers,
+ *                                              the first call takes O(log n) and each next one O(1). Creating or deleting
+ *                                              a parameter between calls may skip or repeat one, start again from 0.
+ */
+unsigned char Parameters_Find_Prefix(PARAMETERS_CB_T *moudule, const char *prefix, unsigned short *cursor, char *name,
+                                     void *value)
+{
+    unsigned char type;
+    unsigned int sequence;
+    unsigned char key[16];
+    unsigned char length = 0;
+
+    memset(key, EMPTY_BYTE, 16);
+    while (length < 16 && prefix[length] != EMPTY_BYTE)
+    {
+        key[length] = prefix[length];
+        length++;
+    }
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        type = Parameters_Sort_Read(moudule, key, length, NULL, cursor, name, value);
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return type;
+}
+
+/**
+ * @description:                                Get the next parameter whose identifier is in a range
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *first                   lowest identifier of the range
+ * @param       {char} *last                    identifier the range stops before, NULL to go to the end
+ * @param       {unsigned short} *cursor        0 before the first call, then left as returned
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 when there is no more
+ * @note       :                                Identifiers are ordered as strings of bytes, see Parameters_Find_Prefix
+ */
+unsigned char Parameters_Find_Range(PARAMETERS_CB_T *moudule, const char *first, const char *last, unsigned short *cursor,
+                                    char *name, void *value)
+{
+    unsigned char type;
+    unsigned int sequence;
+    unsigned char low[16], high[16];
+
+    memset(low, EMPTY_BYTE, 16);
+    strncpy((char *)low, first, 16);
+    if (last != NULL)
+    {
+        memset(high, EMPTY_BYTE, 16);
+        strncpy((char *)high, last, 16);
+    }
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        type = Parameters_Sort_Read(moudule, low, 0, last != NULL ? high : NULL, cursor, name, value);
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return type;
+}
+
+/**
+ * @description:                                Create a parameter as Parameters_Creat and return a handle to its cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {PARAMETERS_TYPE_T} type
+ * @param       {void} *default_value           Address default value.
+ * @param       {PARAMETERS_HANDLE_T} *handle   Handle of the cell
+ * @return      {*}                             success or fail
+ * @note       :                                An existing parameter of another type is not a success
+ */
+bool Parameters_Creat_Handle(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *default_value,
+                             PARAMETERS_HANDLE_T *handle)
+{
+    unsigned char *data = (unsigned char *)Parameters_Creat(moudule, name, type, default_value);
+
+    if (data == NULL)
+    {
+        return false;
+    }
+
+    // packed cells are not evenly spaced, look the index up
+    if (moudule->config.offset_map != NULL)
+    {
+        if (!Parameters_Get_Handle(moudule, name, handle))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        handle->index = (data - moudule->block_start) / sizeof(PARAMETERS_CELL_T);
+        handle->layout = moudule->layout_version;
+    }
+
+    return Parameters_Handle_Valid(moudule, *handle) &&
+           Parameters_Cell(moudule, handle->index)->type == type;
+}
+
+/**
+ * @description:                                Get the handle of an existing parameter
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {PARAMETERS_HANDLE_T} *handle   Handle of the cell
+ * @return      {*}                             If the corresponding identifier is not found, false is returned.
+ * @note       :                                Used to refresh a handle that went stale
+ */
+bool Parameters_Get_Handle(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_HANDLE_T *handle)
+{
+    unsigned short index;
+    bool status;
+    unsigned int sequence;
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        status = Parameters_Search(moudule, name, &index) && index < moudule->table_info.used_number &&
+                 Parameters_Cell(moudule, index)->name[0] != EMPTY_BYTE;
+        if (status)
+        {
+            handle->index = index;
+            handle->layout = moudule->layout_version;
+        }
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return status;
+}
+
+/**
+ * @description:                                Check that a handle still refers to the cell it was taken for
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_HANDLE_T} handle    Handle of the cell
+ * @return      {*}                             valid or stale
+ * @note       :
+ */
+bool Parameters_Handle_Valid(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle)
+{
+    return handle.layout == moudule->layout_version && handle.index < moudule->table_info.used_number &&
+           Parameters_Cell(moudule, handle.index)->name[0] != EMPTY_BYTE;
+}
+
+/**
+ * @description:                                Address of the value of the parameter referred to by a handle
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_HANDLE_T} handle    Handle of the cell
+ * @return      {*}                             Address of value, NULL for a stale handle
+ * @note       :                                The address Parameters_Creat returns, valid while the handle is
+ */
+void *Parameters_Handle_Data(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle)
+{
+    void *data = NULL;
+    unsigned int sequence;
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        data = Parameters_Handle_Valid(moudule, handle) ? Parameters_Cell(moudule, handle.index)->data : NULL;
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return data;
+}
+
+/**
+ * @description:                                Identifier of the parameter referred to by a handle
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_HANDLE_T} handle    Handle of the cell
+ * @param       {char} *name                    Buffer of 17 bytes for the identifier
+ * @return      {*}                             false for a stale handle
+ * @note       :
+ */
+bool Parameters_Handle_Name(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle, char *name)
+{
+    bool status;
+    unsigned int sequence;
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        status = handle.index < moudule->table_info.used_number && Parameters_Page_Ensure(moudule, handle.index) &&
+                 Parameters_Handle_Valid(moudule, handle);
+        if (status)
+        {
+            memcpy(name, Parameters_Cell(moudule, handle.index)->name, 16);
+            name[16] = EMPTY_BYTE;
+        }
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return status;
+}
+
+/**
+ * @description:                                Change the value of the parameter referred to by a handle
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_HANDLE_T} handle    Handle of the cell
+ * @param       {PARAMETERS_TYPE_T} type        Type of value, must be the type of the parameter
+ * @param       {void} *value                   Address of value.
+ * @return      {*}                             success or fail
+ * @note       :                                Stale handles and type mismatches fail without touching the cell
+ */
+bool Parameters_Set_by_handle(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle, PARAMETERS_TYPE_T type, void *value)
+{
+    PARAMETERS_CELL_T *cell;
+    bool status = false;
+
+    OS_LOCK();
+
+    if (Parameters_Handle_Valid(moudule, handle))
+    {
+        cell = Parameters_Cell(moudule, handle.index);
+        if (cell->type == type)
+        {
+            Parameters_Check_Remove(moudule, handle.index);
+            Parameters_Write_Begin(moudule);
+            status = Parameters_Load_value(cell->data, value, type);
+            Parameters_Write_End(moudule);
+            if (status)
+            {
+                Parameters_Changed(moudule, handle.index, cell->name);
+                status = Parameters_Cell_Commit(moudule, handle.index);
+            }
+            else
+            {
+                Parameters_Check_Add(moudule, handle.index);
+            }
+        }
+    }
+
+    OS_UNLOCK();
+    return status;
+}
+
+/**
+ * @description:                                Get the value of the parameter referred to by a handle
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_HANDLE_T} handle    Handle of the cell
+ * @param       {PARAMETERS_TYPE_T} type        Type of value, must be the type of the parameter
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             success or fail
+ * @note       :
+ */
+bool Parameters_Get_by_handle(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle, PARAMETERS_TYPE_T type, void *value)
+{
+    PARAMETERS_CELL_T *cell;
+    bool status;
+    unsigned int sequence;
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        status = false;
+        if (Parameters_Handle_Valid(moudule, handle))
+        {
+            cell = Parameters_Cell(moudule, handle.index);
+            status = Parameters_Cell_Type(moudule, cell) == type && Parameters_Load_value(value, cell->data, type);
+        }
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return status;
+}
+
+/**
+ * @description:                                Find a parameter known at build time
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_ENTRY_T} *entry     the parameter
+ * @param       {unsigned short} fixed          index the parameter has in a table created from the same entries
+ * @param       {PARAMETERS_HANDLE_T} *handle   Handle of the cell
+ * @return      {*}                             found with the type of the entry
+ * @note       :                                The fixed index is checked first and costs no hashing,
+ *                                              the hash index is probed with the hash computed at build time
+ */
+static bool Parameters_Register_Find(PARAMETERS_CB_T *moudule, const PARAMETERS_ENTRY_T *entry, unsigned short fixed,
+                                     PARAMETERS_HANDLE_T *handle)
+{
+    unsigned short index = fixed;
+    bool status;
+    unsigned int sequence;
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        status = index < moudule->table_info.used_number && Parameters_Page_Ensure(moudule, index) &&
+                 Parameters_Name_Equal(Parameters_Cell(moudule, index)->name, entry->name);
+        if (!status)
+        {
+            status = moudule->config.hash_block != NULL ? Parameters_Hash_Search(moudule, (char *)entry->name, entry->hash, &index)
+                                                        : Parameters_Search(moudule, (char *)entry->name, &index);
+            status = status && index < moudule->table_info.used_number &&
+                     Parameters_Cell(moudule, index)->name[0] != EMPTY_BYTE;
+        }
+        if (status)
+        {
+            status = Parameters_Cell_Type(moudule, Parameters_Cell(moudule, index)) == entry->type;
+            handle->index = index;
+            handle->layout = moudule->layout_version;
+        }
+        index = fixed;
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return status;
+}
+
+/**
+ * @description:                                Create or find every parameter of a table known at build time
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_ENTRY_T} *entries   the parameters, usually generated by Parameters_table.h
+ * @param       {unsigned short} number         number of entries
+ * @param       {PARAMETERS_HANDLE_T} *handles  a handle for each entry
+ * @return      {*}                             every parameter has a handle of its type
+ * @note       :                                Missing parameters are created with their default value in one batch
+ *                                              when the table has a dirty block. Parameters kept in ROM with
+ *                                              another type are reported and left as they are.
+ */
+bool Parameters_Register(PARAMETERS_CB_T *moudule, const PARAMETERS_ENTRY_T *entries, unsigned short number,
+                         PARAMETERS_HANDLE_T *handles)
+{
+    unsigned short layout = moudule->layout_version;
+    unsigned short count;
+    bool batch = Parameters_Begin(moudule);
+    bool status = true;
+
+    for (count = 0; count < number; count++)
+    {
+        if (!Parameters_Register_Find(moudule, &entries[count], count, &handles[count]) &&
+            !Parameters_Creat_Handle(moudule, (char *)entries[count].name, entries[count].type,
+                                     (void *)&entries[count].default_value, &handles[count]))
+        {
+            printf("Parameters %s register error\n", entries[count].name);
+            status = false;
+        }
+    }
+    if (batch)
+    {
+        status &= Parameters_Commit(moudule);
+    }
+
+    // reusing a deleted cell changes the layout, handles taken before it are stale
+    for (count = 0; status && layout != moudule->layout_version && count < number; count++)
+    {
+        status = Parameters_Register_Find(moudule, &entries[count], count, &handles[count]);
+    }
+    return status;
+}
+
+/**
+ * @description:                                Generation of the table, bumped by every change
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             generation, 0 until the first change after init
+ * @note       :                                A caller that kept the value knows nothing changed while it stays the same
+ */
+unsigned int Parameters_Generation(PARAMETERS_CB_T *moudule)
+{
+    return moudule->generation;
+}
+
+/**
+ * @description:                                Version of the parameter referred to by a handle
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_HANDLE_T} handle    Handle of the cell
+ * @return      {*}                             generation of its last change, 0 if unchanged since init, stale or no version map
+ * @note       :
+ */
+unsigned int Parameters_Version(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle)
+{
+    unsigned int version;
+    unsigned int sequence;
+
+    if (moudule->config.version_map == NULL)
+    {
+        return 0;
+    }
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        version = Parameters_Handle_Valid(moudule, handle) ? moudule->config.version_map[handle.index] : 0;
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    return version;
+}
+
+/**
+ * @description:                                Take a free subscription slot
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {const char} *name              identifier or prefix to match
+ * @param       {unsigned char} length          bytes of name compared
+ * @param       {void} *notify                  called on every matching change, may be NULL
+ * @param       {void} *context                 passed to notify
+ * @param       {unsigned char} *id             slot taken
+ * @return      {*}                             false if every slot is taken
+ * @note       :                                The caller holds OS_LOCK
+ */
+static bool Parameters_Subscription_Add(PARAMETERS_CB_T *moudule, const char *name, unsigned char length,
+                                        void (*notify)(void *, const char *, unsigned int), void *context, unsigned char *id)
+{
+    PARAMETERS_SUBSCRIPTION_T *subscription;
+    unsigned char count;
+
+    for (count = 0; count < moudule->config.subscription_size; count++)
+    {
+        subscription = &moudule->config.subscription_block[count];
+        if (!subscription->active)
+        {
+            memset(subscription->name, EMPTY_BYTE, sizeof(subscription->name));
+            memcpy(subscription->name, name, length);
+            subscription->length = length;
+            subscription->notify = notify;
+            subscription->context = context;
+            subscription->generation = moudule->generation;
+            subscription->active = true;
+            *id = count;
+            return true;
+        }
+    }
+
+    printf("Parameters 0X%x without subscription\n", (uintptr_t)moudule);
+    return false;
+}
+
+/**
+ * @description:                                Subscribe to the changes of every parameter whose identifier starts with a prefix
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {const char} *prefix            String prefix, "" for every parameter. No longer than 16
+ * @param       {void} *notify                  called on every matching change, NULL to only track the generation
+ * @param       {void} *context                 passed to notify
+ * @param       {unsigned char} *id             subscription for Parameters_Subscription_Generation and Parameters_Unsubscribe
+ * @return      {*}                             success or fail
+ * @note       :                                Creations and deletions match as well as changes
+ */
+bool Parameters_Subscribe(PARAMETERS_CB_T *moudule, const char *prefix,
+                          void (*notify)(void *, const char *, unsigned int), void *context, unsigned char *id)
+{
+    bool status;
+    unsigned char length = 0;
+
+    while (length < 16 && prefix[length] != EMPTY_BYTE)
+    {
+        length++;
+    }
+
+    OS_LOCK();
+    status = Parameters_Subscription_Add(moudule, prefix, length, notify, context, id);
+    OS_UNLOCK();
+    return status;
+}
+
+/**
+ * @description:                                Subscribe to the changes of the parameter referred to by a handle
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_HANDLE_T} handle    Handle of the cell
+ * @param       {void} *notify                  called on every change, NULL to only track the generation
+ * @param       {void} *context                 passed to notify
+ * @param       {unsigned char} *id             subscription for Parameters_Subscription_Generation and Parameters_Unsubscribe
+ * @return      {*}                             false if the handle is stale or every slot is taken
+ * @note       :                                The subscription follows the identifier, it outlives the handle
+ */
+bool Parameters_Subscribe_Handle(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle,
+                                 void (*notify)(void *, const char *, unsigned int), void *context, unsigned char *id)
+{
+    bool status = false;
+
+    OS_LOCK();
+    if (Parameters_Handle_Valid(moudule, handle))
+    {
+        status = Parameters_Subscription_Add(moudule, Parameters_Cell(moudule, handle.index)->name, 16, notify, context, id);
+    }
+    OS_UNLOCK();
+    return status;
+}
+
+/**
+ * @description:                                Release a subscription
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} id              subscription to release
+ * @return      {*}                             false if it was not active
+ * @note       :
+ */
+bool Parameters_Unsubscribe(PARAMETERS_CB_T *moudule, unsigned char id)
+{
+    bool status = false;
+
+    OS_LOCK();
+    if (id < moudule->config.subscription_size && moudule->config.subscription_block[id].active)
+    {
+        moudule->config.subscription_block[id].active = false;
+        status = true;
+    }
+    OS_UNLOCK();
+    return status;
+}
+
+/**
+ * @description:                                Generation of the last change matching a subscription
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} id              subscription
+ * @return      {*}                             generation, 0 for an unknown subscription
+ * @note       :                                Polling it is a single integer compare, no lookup or copy
+ */
+unsigned int Parameters_Subscription_Generation(PARAMETERS_CB_T *moudule, unsigned char id)
+{
+    if (id >= moudule->config.subscription_size)
+    {
+        return 0;
+    }
+    return moudule->config.subscription_block[id].generation;
+}
+
+/**
+ * @description:                                Index seen by Parameters_Get_by_index of a cell
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned short} slot           index of the cell in the block
+ * @return      {*}                             index not counting tombstones
+ * @note       :
+ */
+static unsigned short Parameters_Dense_Index(PARAMETERS_CB_T *moudule, unsigned short slot)
+{
+    unsigned short index = 0;
+    unsigned short search;
+
+    if (moudule->free_number == 0)
+    {
+        return slot;
+    }
+
+    for (search = 0; search < slot; search++)
+    {
+        if (!PARAMETERS_IS_TOMBSTONE(Parameters_Cell(moudule, search)))
+        {
+            index++;
+        }
+    }
+    return index;
+}
+
+/**
+ * @description:                                Get the parameters changed after a generation
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned int} since            generation already seen, until of the previous call
+ * @param       {PARAMETERS_CHANGE_T} *changes  buffer for the changed parameters, oldest change first
+ * @param       {unsigned short} size           entries of the buffer
+ * @param       {unsigned short} *number        entries filled
+ * @param       {unsigned int} *until           generation to pass as since to the next call
+ * @return      {*}                             false if the changes since that generation are not known any more,
+ *                                              the whole table must be read again and until taken as the new start
+ * @note       :                                Cost follows the number of changes, not the size of the table.
+ *                                              A full buffer stops early, until then points at the first change left.
+ */
+bool Parameters_Get_Changes(PARAMETERS_CB_T *moudule, unsigned int since, PARAMETERS_CHANGE_T *changes, unsigned short size,
+                            unsigned short *number, unsigned int *until)
+{
+    PARAMETERS_LOG_T log;
+    PARAMETERS_CELL_T *cell;
+    unsigned int mask = moudule->config.change_size - 1;
+    unsigned int position, oldest;
+    unsigned int sequence;
+    unsigned short count, search;
+    bool status;
+
+    *number = 0;
+    *until = moudule->generation;
+    if (moudule->config.change_log == NULL)
+    {
+        return false;
+    }
+
+    do
+    {
+        sequence = Parameters_Read_Begin(moudule);
+        count = 0;
+        *until = moudule->generation;
+        status = since >= moudule->change_floor && since <= moudule->generation;
+
+        // the log is in generation order, find the first entry after since
+        position = moudule->change_head;
+        oldest = position > moudule->config.change_size ? position - moudule->config.change_size : 0;
+        while (status && position > oldest && moudule->config.change_log[(position - 1) & mask].generation > since)
+        {
+            position--;
+        }
+
+        for (; status && position != moudule->change_head; position++)
+        {
+            log = moudule->config.change_log[position & mask];
+            if (log.index >= moudule->table_info.used_number ||
+                (moudule->config.version_map != NULL && moudule->config.version_map[log.index] != log.generation))
+            {
+                // changed again later, reported with that change
+                continue;
+            }
+
+            cell = Parameters_Cell(moudule, log.index);
+            if (moudule->config.version_map == NULL)
+            {
+                // without versions a cell changed twice is found in the buffer
+                for (search = 0; search < count; search++)
+                {
+                    if (strncmp(changes[search].name, cell->name, 16) == 0)
+                    {
+                        changes[search].version = log.generation;
+                        break;
+                    }
+                }
+                if (search < count)
+                {
+                    continue;
+                }
+            }
+
+            if (count == size)
+            {
+                *until = log.generation - 1;
+                break;
+            }
+
+            memset(&changes[count], 0, sizeof(PARAMETERS_CHANGE_T));
+            changes[count].version = log.generation;
+            changes[count].index = Parameters_Dense_Index(moudule, log.index);
+            strncpy(changes[count].name, cell->name, 16);
+            changes[count].type = Parameters_Cell_Type(moudule, cell);
+            memcpy(changes[count].value, cell->data, Parameters_Type_Width(changes[count].type));
+            count++;
+        }
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    *number = count;
+    return status;
+}
+
+/**
+ * @description:                                Write ROM from a copy taken by the write-behind task
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {unsigned char} *data           copy of the bytes
+ * @param       {unsigned int} offset           offset in ROM from the table information
+ * @param       {unsigned int} size             number of bytes
+ * @return      {*}                             success or fail
+ * @note       :                                Retried at once like Parameters_Bytes_SYNC, backing off is left to the task
+ */
+static bool Parameters_Async_Write(PARAMETERS_CB_T *moudule, unsigned char *data, unsigned int offset, unsigned int size)
+{
+    unsigned char max_retry = 4;
+
+    while (max_retry)
+    {
+        if (Parameters_ROM(moudule, 1, data, moudule->ROM_start_offset + offset, size))
+        {
+            return true;
+        }
+        max_retry--;
+        PARAMETERS_STAT_ADD(moudule, retries, max_retry != 0);
+    }
+    PARAMETERS_STAT_ADD(moudule, failures, 1);
+    return false;
+}
+
+/**
+ * @description:                                Write the queued cells and then the table information to ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             true once the ring is empty and ROM holds the table, false on a write failure
+ * @note       :                                Called by a single task. Cells are copied out of RAM the way readers do,
+ *                                              no lock is held across Write_2_ROM. A cell that failed stays queued,
+ *                                              call again later.
+ */
+bool Parameters_Async_Drain(PARAMETERS_CB_T *moudule)
+{
+    bool status = true;
+    PARAMETERS_WIDE_CELL_T cell;
+    PARAMETERS_TABLE_INFO_T info;
+    unsigned int tail = moudule->async_tail;
+    unsigned int offset = 0;
+    unsigned int size;
+    unsigned int sequence;
+    unsigned short index;
+
+    if (moudule->config.async_ring == NULL)
+    {
+        return false;
+    }
+
+    while (tail != moudule->async_head)
+    {
+        PARAMETERS_BARRIER();
+        index = moudule->config.async_ring[tail & (moudule->config.async_size - 1)];
+        size = 0;
+        if (index == PARAMETERS_ASYNC_INFO)
+        {
+            __sync_fetch_and_and(&moudule->async_info, 0);
+        }
+        else
+        {
+            // the mark is cleared before the copy, a change made meanwhile queues the cell again
+            __sync_fetch_and_and(&moudule->config.dirty_block[index >> 3], ~(1 << (index & 7)));
+            do
+            {
+                sequence = Parameters_Read_Begin(moudule);
+                size = 0;
+                if (index < moudule->table_info.used_number)
+                {
+                    offset = Parameters_Cell_Offset(moudule, index);
+                    size = Parameters_Cell_Size(moudule, index);
+                }
+                else if (moudule->config.offset_map == NULL)
+                {
+                    // the slot left empty by a deletion
+                    offset = index * sizeof(PARAMETERS_CELL_T);
+                    size = sizeof(PARAMETERS_CELL_T);
+                }
+                if (size > sizeof(PARAMETERS_WIDE_CELL_T) || offset + size > moudule->block_size)
+                {
+                    size = 0;
+                }
+                memcpy(&cell, moudule->block_start + offset, size);
+            } while (Parameters_Read_Retry(moudule, sequence));
+        }
+
+        if (size != 0 && !Parameters_Async_Write(moudule, (unsigned char *)&cell, sizeof(PARAMETERS_TABLE_INFO_T) + offset, size))
+        {
+            __sync_fetch_and_or(&moudule->config.dirty_block[index >> 3], 1 << (index & 7));
+            printf("Parameters 0X%x SYNC cell:%d failed! type 1\n", (uintptr_t)moudule, index);
+            return false;
+        }
+        tail++;
+        moudule->async_tail = tail;
+    }
+
+    if (moudule->async_durable != tail)
+    {
+        do
+        {
+            sequence = Parameters_Read_Begin(moudule);
+            info = moudule->table_info;
+        } while (Parameters_Read_Retry(moudule, sequence));
+
+        status = Parameters_Async_Write(moudule, (unsigned char *)&info, 0, sizeof(PARAMETERS_TABLE_INFO_T));
+        if (status)
+        {
+            __sync_fetch_and_add(&moudule->saved_writes, tail - moudule->async_durable - 1);
+            PARAMETERS_BARRIER();
+            moudule->async_durable = tail;
+        }
+        else
+        {
+            printf("Parameters 0X%x SYNC info failed! type :1\n", (uintptr_t)moudule);
+        }
+    }
+    return status;
+}
+
+/**
+ * @description:                                Wait until the changes made so far are in ROM
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             success or fail
+ * @note       :                                Without a write-behind ring every change is already in ROM.
+ *                                              Without a task attached the ring is drained by the caller.
+ */
+bool Parameters_Flush(PARAMETERS_CB_T *moudule)
+{
+    unsigned int target = moudule->async_head;
+
+    if (moudule->config.async_ring == NULL)
+    {
+        return true;
+    }
+
+    if (moudule->Async_Wait != NULL)
+    {
+        return moudule->Async_Wait(moudule->async_worker, target);
+    }
 
-        if (strcmp(temp, name) == 0 || temp[0] == EMPTY_BYTE)
+    while ((int)(moudule->async_durable - target) < 0)
+    {
+        if (!Parameters_Async_Drain(moudule))
         {
-            status = true;
-            break;
+            return false;
         }
-        search += sizeof(PARAMETERS_CELL_T);
-        (*index)++;
     }
-
-    return status;
+    return true;
 }
 
 /**
- * @description:                                Assign values to a block of data by type
- * @param       {void} *dst                     Destation
- * @param       {void} *src                     Source
- * @param       {PARAMETERS_TYPE_T} type
- * @return      {*}                             success or fail
- * @note       :
+ * @description:                                Open a batch, changes are kept in RAM until Parameters_Commit
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @return      {*}                             If no dirty bitmap is configured, false is returned.
+ * @note       :                                Batches nest, the outermost Parameters_Commit writes ROM.
+ *                                              A journal already writes one record per change, it has no batches,
+ *                                              nor has the write-behind ring, which coalesces on its own.
  */
-static bool Parameters_Load_value(void *dst, void *src, PARAMETERS_TYPE_T type)
+bool Parameters_Begin(PARAMETERS_CB_T *moudule)
 {
-    ISR_LOCK();
-
-    bool status = true;
-    switch (type)
+    if (moudule->config.dirty_block == NULL || moudule->config.journal_size != 0 || moudule->config.async_ring != NULL)
     {
-    case PARAMETERS_TYPE_UINT8:
-    case PARAMETERS_TYPE_INT8:
-        memcpy(dst, src, 1);
-        break;
-    case PARAMETERS_TYPE_UINT16:
-    case PARAMETERS_TYPE_INT16:
-        memcpy(dst, src, 2);
-        break;
-    case PARAMETERS_TYPE_UINT32:
-    case PARAMETERS_TYPE_INT32:
-    case PARAMETERS_TYPE_F32:
-        memcpy(dst, src, 4);
-        break;
-    case PARAMETERS_TYPE_UINT64:
-    case PARAMETERS_TYPE_INT64:
-    case PARAMETERS_TYPE_F64:
-        printf("don't support");
-        // memcpy(dst, src, 8);
-        // break;
-
-    default:
-        status = false;
-        break;
+        return false;
     }
 
-    ISR_UNLOCK();
-    return status;
+    OS_LOCK();
+    moudule->batch_depth++;
+    OS_UNLOCK();
+    return true;
 }
 
 /**
- * @description:
+ * @description:                                Close a batch and write the changed cells to ROM
  * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
- * @param       {char} *table_tag               String identifier. Must end with '\0' and be no longer than 16
- * @param       {unsigned char} *RAM_block      Address of a storage block allocated in RAM
- * @param       {unsigned int} ROM_block        Offset address of a storage block allocated in ROM
- * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
- * @param       {bool char} Read_From_ROM       Funtion of read data from ROM
- * @param       {bool} Write_2_ROM              Funtion of write data to ROM
- * @param       {unsigned short} checkout       Funtion of data checkout
  * @return      {*}                             success or fail
- * @note       :
+ * @note       :                                Adjacent dirty cells are written with one Write_2_ROM call,
+ *                                              followed by a single write of the table information.
+ *                                              Cells that failed stay dirty for the next commit.
  */
-bool Parameters_Init(PARAMETERS_CB_T *moudule, char *table_tag, unsigned char *RAM_block, unsigned int ROM_block, unsigned int size,
-                     bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
-                     bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
-                     unsigned short (*checkout)(unsigned char *, unsigned int))
+bool Parameters_Commit(PARAMETERS_CB_T *moudule)
 {
     bool status = true;
     unsigned short index = 0;
+    unsigned short start;
+    unsigned short number = moudule->block_size / sizeof(PARAMETERS_CELL_T);
+    unsigned int issued = 1;
 
-    moudule->block_start = RAM_block;
-    moudule->ROM_start_offset = ROM_block;
-    moudule->block_size = size;
-
-    memset(moudule->block_start, EMPTY_BYTE, moudule->block_size);
+    // nothing past the end of a packed table needs writing
+    if (moudule->config.offset_map != NULL)
+    {
+        number = moudule->table_info.used_number;
+    }
 
-    moudule->Read_From_ROM = Read_From_ROM;
-    moudule->Write_2_ROM = Write_2_ROM;
-    moudule->checkout = checkout;
+    if (moudule->batch_depth == 0)
+    {
+        return false;
+    }
 
-    // load table info
-    status = Parameters_Info_SYNC(moudule, 2, 4);
+    OS_LOCK();
 
-    if (status)
+    moudule->batch_depth--;
+    if (moudule->batch_depth == 0 && moudule->batch_pending != 0)
     {
-        if (!strcmp(moudule->table_info.table_tag, table_tag) == 0)
+        while (index < number)
         {
-            // This is a whole new memory area that needs to write new information
-            memset(moudule->table_info.table_tag, EMPTY_BYTE, 16);
-            strcpy(moudule->table_info.table_tag, table_tag);
-            moudule->table_info.used_number = 0;
-            moudule->table_info.check_value = moudule->checkout(moudule->block_start, 0);
+            if ((moudule->config.dirty_block[index >> 3] & (1 << (index & 7))) == 0)
+            {
+                index++;
+                continue;
+            }
+
+            start = index;
+            while (index < number && (moudule->config.dirty_block[index >> 3] & (1 << (index & 7))))
+            {
+                index++;
+            }
 
-            status = Parameters_Info_SYNC(moudule, 1, 4);
+            issued++;
+            if (Parameters_Range_SYNC(moudule, start, index - start, 1, 4))
+            {
+                while (start < index)
+                {
+                    moudule->config.dirty_block[start >> 3] &= ~(1 << (start & 7));
+                    start++;
+                }
+            }
+            else
+            {
+                status = false;
+            }
         }
-    }
 
-    if (status)
-    {
-        // load ROM to RAM
-        while (index < moudule->table_info.used_number)
+        if (moudule->page_dirty)
         {
-            status = Parameters_Cell_SYNC(moudule, index, 2, 4);
-            if (status)
+            issued++;
+            if (Parameters_Page_SYNC(moudule, 0, Parameters_Page_Number(moudule), 1))
             {
-                index++;
+                moudule->page_dirty = false;
             }
             else
             {
-                break;
+                status = false;
             }
         }
-    }
-
-    if (status)
-    {
-        // checkout
-        if (!(moudule->checkout(moudule->block_start, index * sizeof(PARAMETERS_CELL_T)) ==
-              moudule->table_info.check_value))
+        status &= Parameters_Info_SYNC(moudule, 1, 4);
+        if (moudule->batch_pending > issued)
         {
-            printf("Parameters 0X%x checkout error!\n", (uintptr_t)moudule);
-            status = false;
+            moudule->saved_writes += moudule->batch_pending - issued;
         }
+        moudule->batch_pending = 0;
     }
 
+    OS_UNLOCK();
     return status;
 }
 
 /**
- * @description:                                Create a storage cell based on the parameter identifier and fill it with the default value,
- *                                              returning the current stored value if the parameter already exists.
+ * @description:                                Squeeze the tombstones out of the table
  * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
- * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
- * @param       {PARAMETERS_TYPE_T} type
- * @param       {void} *default_value           Address default value.
- * @return      {*}                             Address of value.
- * @note       :                                If no identifier is found and there is no space left to create a cell, NULL is returned.
+ * @return      {*}                             success or fail
+ * @note       :                                Cells from the first tombstone on are moved down and written to ROM
+ *                                              with one Write_2_ROM call. Handles become stale.
  */
-void *Parameters_Creat(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *default_value)
+bool Parameters_Compact(PARAMETERS_CB_T *moudule)
 {
-    PARAMETERS_CELL_T *cell = NULL;
-    void *ret = NULL;
-    unsigned short index;
+    bool status = true;
+    PARAMETERS_CELL_T *cell;
+    unsigned short first = 0;
+    unsigned short search;
+    unsigned short used;
 
     OS_LOCK();
 
-    if (Parameters_Search(moudule, name, &index))
+    if (moudule->free_number != 0)
     {
-        cell = (PARAMETERS_CELL_T *)(moudule->block_start + index * sizeof(PARAMETERS_CELL_T));
-        ret = cell->data;
-        if (cell->name[0] == EMPTY_BYTE)
+        Parameters_Write_Begin(moudule);
+        while (!PARAMETERS_IS_TOMBSTONE(Parameters_Cell(moudule, first)))
         {
-            strcpy(cell->name, name);
-            cell->type = type;
+            first++;
+        }
 
-            if (!Parameters_Load_value(cell->data, default_value, type))
+        used = first;
+        for (search = first; search < moudule->table_info.used_number; search++)
+        {
+            cell = Parameters_Cell(moudule, search);
+            if (!PARAMETERS_IS_TOMBSTONE(cell))
             {
-                printf("Parameters %s type error\n", name);
+                memcpy(moudule->block_start + used * sizeof(PARAMETERS_CELL_T), cell, sizeof(PARAMETERS_CELL_T));
+                if (moudule->config.version_map != NULL)
+                {
+                    moudule->config.version_map[used] = moudule->config.version_map[search];
+                }
+                used++;
             }
-            else
-            {
-                moudule->table_info.used_number++;
-                moudule->table_info.check_value = moudule->checkout(moudule->block_start, moudule->table_info.used_number * sizeof(PARAMETERS_CELL_T));
+        }
+        if (moudule->config.version_map != NULL)
+        {
+            memset(moudule->config.version_map + used, 0, (moudule->table_info.used_number - used) * sizeof(unsigned int));
+        }
+        memset(moudule->block_start + used * sizeof(PARAMETERS_CELL_T), EMPTY_BYTE,
+               (moudule->table_info.used_number - used) * sizeof(PARAMETERS_CELL_T));
 
-                Parameters_Cell_SYNC(moudule, index, 1, 4);
-                Parameters_Info_SYNC(moudule, 1, 4);
-            }
+        search = moudule->table_info.used_number;
+        moudule->table_info.used_number = used;
+        moudule->table_info.check_value = Parameters_Check_Table(moudule, used);
+        moudule->change_floor = moudule->generation;
+        Parameters_Free_Build(moudule);
+        Parameters_Hash_Build(moudule);
+        Parameters_Name_Build(moudule);
+        Parameters_Sort_Build(moudule);
+        moudule->layout_version++;
+        if (moudule->layout_version == 0)
+        {
+            moudule->layout_version = 1;
+        }
+        Parameters_Write_End(moudule);
+
+        if (!Parameters_Batch_Mark(moudule, first, search - first))
+        {
+            status = Parameters_Range_SYNC(moudule, first, search - first, 1, 4);
+            status &= Parameters_Info_SYNC(moudule, 1, 4);
         }
-    }
-    else
-    {
-        printf("Parameters 0X%x without space\n", (uintptr_t)moudule);
     }
 
     OS_UNLOCK();
-    return ret;
+    return status;
 }
 
 /**
- * @description:                                Change the value of the parameter
+ * @description:                                Copy every parameter into a snapshot for Parameters_Import
  * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
- * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
- * @param       {void} *value                   Address of value.
- * @return      {*}                             Address of value.
- * @note       :                                If the corresponding identifier is not found, NULL is returned.
+ * @param       {unsigned char} *buffer         PARAMETERS_SNAPSHOT_T followed by the entries
+ * @param       {unsigned int} size             bytes of the buffer
+ * @param       {unsigned int} *length          bytes of the snapshot
+ * @return      {*}                             If the buffer is too small, false is returned and length is the size needed.
+ * @note       :                                The entries are sorted by identifier while they are copied,
+ *                                              tables of the same parameters give the same snapshot.
  */
-void *Parameters_Chanege(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *value)
+bool Parameters_Export(PARAMETERS_CB_T *moudule, unsigned char *buffer, unsigned int size, unsigned int *length)
 {
-    PARAMETERS_CELL_T *cell = NULL;
-    void *ret = NULL;
+    PARAMETERS_SNAPSHOT_T head;
+    PARAMETERS_CELL_T *cell;
+    unsigned char *entries = buffer + sizeof(PARAMETERS_SNAPSHOT_T);
+    unsigned int room = size > sizeof(PARAMETERS_SNAPSHOT_T) ? size - sizeof(PARAMETERS_SNAPSHOT_T) : 0;
+    unsigned int entry, position, last;
+    unsigned int sequence;
     unsigned short index;
+    bool status;
 
-    if (Parameters_Search(moudule, name, &index))
+    do
     {
-
-        cell = (PARAMETERS_CELL_T *)(moudule->block_start + index * sizeof(PARAMETERS_CELL_T));
-        if (cell->type != type)
-        {
-            return ret;
-        }
-
-        if (cell->name[0] != EMPTY_BYTE)
+        sequence = Parameters_Read_Begin(moudule);
+        status = true;
+        head.number = 0;
+        head.length = 0;
+        last = 0;
+        for (index = 0; index < moudule->table_info.used_number; index++)
         {
-            ret = cell->data;
-            if (!Parameters_Load_value(cell->data, value, cell->type))
+            if (Parameters_Cell_Offset(moudule, index) + PARAMETERS_CELL_HEAD > moudule->block_size)
             {
-                printf("Parameters %s type error\n", name);
+                break;
             }
-            else
+            if (!Parameters_Page_Ensure(moudule, index))
+            {
+                status = false;
+                break;
+            }
+            cell = Parameters_Cell(moudule, index);
+            entry = Parameters_Type_Width(Parameters_Cell_Type(moudule, cell));
+            if (cell->name[0] == EMPTY_BYTE || entry == 0)
             {
-                moudule->table_info.check_value = moudule->checkout(moudule->block_start, moudule->table_info.used_number * sizeof(PARAMETERS_CELL_T));
+                continue;
+            }
+            entry += PARAMETERS_CELL_HEAD;
 
-                Parameters_Cell_SYNC(moudule, index, 1, 4);
-                Parameters_Info_SYNC(moudule, 1, 4);
+            status = status && head.length + entry <= room;
+            if (status && head.number != 0 && strncmp((char *)entries + last, cell->name, 16) > 0)
+            {
+                // cells mostly come in order, an older one is moved up to make room
+                for (position = 0; strncmp((char *)entries + position, cell->name, 16) < 0;)
+                {
+                    position += PARAMETERS_CELL_HEAD + Parameters_Type_Width(entries[position + 16]);
+                }
+                memmove(entries + position + entry, entries + position, head.length - position);
+                memcpy(entries + position, cell, entry);
+                last += entry;
             }
+            else if (status)
+            {
+                memcpy(entries + head.length, cell, entry);
+                last = head.length;
+            }
+            head.length += entry;
+            head.number++;
         }
+    } while (Parameters_Read_Retry(moudule, sequence));
+
+    *length = sizeof(PARAMETERS_SNAPSHOT_T) + head.length;
+    if (!status)
+    {
+        return false;
     }
 
-    return ret;
+    head.magic = PARAMETERS_SNAPSHOT_MAGIC;
+    head.check_value = Parameters_Checkout(moudule, entries, head.length);
+    memcpy(buffer, &head, sizeof(PARAMETERS_SNAPSHOT_T));
+    return true;
 }
 
 /**
- * @description:                                Delete an existing parameter storage cell
+ * @description:                                Apply a snapshot of Parameters_Export to the table
  * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
- * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
- * @return      {*}                             If the corresponding identifier is not found, false is returned.
- * @note       :
+ * @param       {unsigned char} *snapshot       PARAMETERS_SNAPSHOT_T followed by the entries
+ * @param       {unsigned int} length           bytes of the snapshot
+ * @param       {unsigned short} *applied       entries the table holds afterwards, the others have another type
+ *                                              or did not fit
+ * @return      {*}                             false if the snapshot is damaged or ROM could not be written
+ * @note       :                                The snapshot is checked before the table is touched. Existing parameters
+ *                                              take the value of the snapshot, missing ones are created, others are kept.
+ *                                              RAM is changed in one pass and the check value computed once. With banks
+ *                                              the table is written to the inactive bank and commits with its head,
+ *                                              on failure the table of the active bank is loaded again. Otherwise the
+ *                                              changed range is written with one Write_2_ROM call, or left to an open
+ *                                              batch. Seqlock readers see the old set or the whole new one, never a part,
+ *                                              and go on while ROM is written. The changes are announced after the
+ *                                              write, a failed bank switch reloads the old set and announces none.
+ *                                              Not available with the journal storage or the lazy loading mode.
  */
-bool Parameters_Del(PARAMETERS_CB_T *moudule, char *name)
+bool Parameters_Import(PARAMETERS_CB_T *moudule, const unsigned char *snapshot, unsigned int length,
+                       unsigned short *applied)
 {
-    bool status = false;
-    PARAMETERS_CELL_T *cell = NULL;
+    PARAMETERS_SNAPSHOT_T head;
+    PARAMETERS_WIDE_CELL_T temp;
+    PARAMETERS_CELL_T *cell;
+    const unsigned char *entries = snapshot + sizeof(PARAMETERS_SNAPSHOT_T);
+    const unsigned char *previous = NULL;
+    unsigned int position = 0;
+    unsigned short number = 0;
+    unsigned short first = PARAMETERS_NO_CELL;
+    unsigned short last = 0;
     unsigned short index;
-    unsigned short temp_index;
+    unsigned short changed[PARAMETERS_IMPORT_NOTIFY];
+    unsigned short notify = 0;
+    unsigned char width = 0;
+    char name[17];
+    bool status;
+
+    *applied = 0;
+    if (length >= sizeof(PARAMETERS_SNAPSHOT_T))
+    {
+        memcpy(&head, snapshot, sizeof(PARAMETERS_SNAPSHOT_T));
+    }
+    status = length >= sizeof(PARAMETERS_SNAPSHOT_T) && head.magic == PARAMETERS_SNAPSHOT_MAGIC &&
+             head.length == length - sizeof(PARAMETERS_SNAPSHOT_T);
+
+    // every entry must parse and come after the previous one
+    while (status && position < head.length)
+    {
+        status = position + PARAMETERS_CELL_HEAD <= head.length && entries[position] != EMPTY_BYTE &&
+                 (width = Parameters_Type_Width(entries[position + 16])) != 0 &&
+                 position + PARAMETERS_CELL_HEAD + width <= head.length &&
+                 (previous == NULL || strncmp((const char *)previous, (const char *)entries + position, 16) < 0);
+        previous = entries + position;
+        position += PARAMETERS_CELL_HEAD + width;
+        number++;
+    }
+    status = status && number == head.number &&
+             Parameters_Checkout(moudule, (unsigned char *)entries, head.length) == head.check_value;
+    if (!status || moudule->config.journal_size != 0 || moudule->config.lazy_page != 0)
+    {
+        printf("Parameters 0X%x snapshot error!\n", (uintptr_t)moudule);
+        return false;
+    }
 
     OS_LOCK();
 
-    if (Parameters_Search(moudule, name, &index))
+    // readers see the whole set applied or none of it
+    Parameters_Write_Begin(moudule);
+    name[16] = EMPTY_BYTE;
+    for (position = 0; position < head.length; position += PARAMETERS_CELL_HEAD + width)
     {
-        cell = (PARAMETERS_CELL_T *)(moudule->block_start + index * sizeof(PARAMETERS_CELL_T));
+        width = Parameters_Type_Width(entries[position + 16]);
+        memcpy(name, entries + position, 16);
+
+        // not found, reuse a deleted cell before growing the table
+        status = Parameters_Search(moudule, name, &index);
+        if ((!status || Parameters_Cell(moudule, index)->name[0] == EMPTY_BYTE) && Parameters_Free_Peek(moudule, &index))
+        {
+            status = true;
+        }
+        if (!status)
+        {
+            continue;
+        }
+
+        cell = Parameters_Cell(moudule, index);
         if (cell->name[0] != EMPTY_BYTE)
         {
-            temp_index = index;
-            memset(cell, EMPTY_BYTE, sizeof(PARAMETERS_CELL_T));
-            while (temp_index < moudule->table_info.used_number)
+            if (cell->type != entries[position + 16])
             {
-                memcpy(cell, (void *)(cell + 1), sizeof(PARAMETERS_CELL_T));
-                temp_index++;
-                cell++;
+                continue;
             }
-            memset(cell, EMPTY_BYTE, sizeof(PARAMETERS_CELL_T));
+            (*applied)++;
+            if (memcmp(cell->data, entries + position + PARAMETERS_CELL_HEAD, width) == 0)
+            {
+                continue;
+            }
+            memcpy(cell->data, entries + position + PARAMETERS_CELL_HEAD, width);
+        }
+        else
+        {
+            if ((moudule->config.offset_map == NULL && width > sizeof(cell->data)) ||
+                (moudule->config.offset_map != NULL && index == moudule->table_info.used_number &&
+                 moudule->config.offset_map[index] + PARAMETERS_CELL_HEAD + width > moudule->block_size))
+            {
+                continue;
+            }
+            (*applied)++;
+            memset(&temp, EMPTY_BYTE, sizeof(temp));
+            memcpy(&temp, entries + position, PARAMETERS_CELL_HEAD + width);
+            Parameters_Cell_Place(moudule, index, &temp);
+        }
+        if (notify < PARAMETERS_IMPORT_NOTIFY)
+        {
+            changed[notify] = index;
+        }
+        notify++;
+        first = index < first ? index : first;
+        last = index > last ? index : last;
+    }
+
+    if (first != PARAMETERS_NO_CELL)
+    {
+        moudule->table_info.check_value = Parameters_Check_Table(moudule, moudule->table_info.used_number);
+    }
+    Parameters_Write_End(moudule);
 
-            moudule->table_info.used_number--;
-            moudule->table_info.check_value = moudule->checkout(moudule->block_start, moudule->table_info.used_number * sizeof(PARAMETERS_CELL_T));
+    status = true;
+    if (first != PARAMETERS_NO_CELL && moudule->config.banks)
+    {
+        status = Parameters_Bank_Switch(moudule);
+        if (!status)
+        {
+            Parameters_Write_Begin(moudule);
+            Parameters_Bank_Reload(moudule);
+            Parameters_Write_End(moudule);
+            *applied = 0;
+        }
+    }
+    else if (first != PARAMETERS_NO_CELL && !Parameters_Batch_Mark(moudule, first, last - first + 1))
+    {
+        status = Parameters_Range_SYNC(moudule, first, last - first + 1, 1, 4);
+        status &= Parameters_Info_SYNC(moudule, 1, 4);
+    }
 
-            while (index <= moudule->table_info.used_number)
+    // only a committed set is announced, subscribers may read the table
+    if (status && notify <= PARAMETERS_IMPORT_NOTIFY)
+    {
+        for (position = 0; position < notify; position++)
+        {
+            Parameters_Changed(moudule, changed[position], Parameters_Cell(moudule, changed[position])->name);
+        }
+    }
+    else if (status)
+    {
+        for (position = 0; position < head.length; position += PARAMETERS_CELL_HEAD + width)
+        {
+            width = Parameters_Type_Width(entries[position + 16]);
+            memcpy(name, entries + position, 16);
+            if (Parameters_Search(moudule, name, &index) && Parameters_Cell(moudule, index)->type == entries[position + 16])
             {
-                Parameters_Cell_SYNC(moudule, index, 1, 4);
-                index++;
+                Parameters_Changed(moudule, index, name);
             }
-            Parameters_Info_SYNC(moudule, 1, 4);
-            status = true;
         }
     }
 
     OS_UNLOCK();
-
     return status;
 }
 
 /**
- * @description:                                Get the identifier of the parameter based on the index
+ * @description:                                Copy the runtime counters of a table
  * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
- * @param       {unsigned short} index          index
- * @param       {char} *name                    identifier of the parameter
- * @param       {void} *value                   value of parameter
- * @return      {*}
- * @note       :
+ * @param       {PARAMETERS_STATS_T} *stats     counters since init or Parameters_Reset_Stats
+ * @return      {*}                             false when the library is built without PARAMETERS_STATS
+ * @note       :                                Counts of lock-free readers and of Parameters_Async_Drain are not
+ *                                              serialized with writers and may miss some increments
  */
-unsigned char Parameters_Get_by_index(PARAMETERS_CB_T *moudule, unsigned short index, char *name, void *value)
+bool Parameters_Get_Stats(PARAMETERS_CB_T *moudule, PARAMETERS_STATS_T *stats)
 {
-    PARAMETERS_CELL_T *cell = NULL;
-    unsigned char type = 0;
-
-    if (index > moudule->table_info.used_number)
-    {
-        return type;
-    }
-
-    cell = (PARAMETERS_CELL_T *)(moudule->block_start + index * sizeof(PARAMETERS_CELL_T));
-
-    if (cell->name[0] != EMPTY_BYTE)
-    {
-        memcpy(name, cell->name, 16);
-        type = cell->type;
-        Parameters_Load_value(value, cell->data, cell->type);
-    }
-    return type;
+#if PARAMETERS_STATS
+    OS_LOCK();
+    memcpy(stats, &moudule->stats, sizeof(PARAMETERS_STATS_T));
+    OS_UNLOCK();
+    return true;
+#else
+    (void)moudule;
+    memset(stats, 0, sizeof(PARAMETERS_STATS_T));
+    return false;
+#endif
 }
 
 /**
- * @description:                                Get the index of the parameter based on the identifier
+ * @description:                                Restart the runtime counters of a table from 0
  * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
- * @param       {char} *name                    identifier of the parameter
- * @param       {unsigned short} *index         index
- * @param       {void} *value                   value of parameter
  * @return      {*}
  * @note       :
  */
-unsigned char Parameters_Get_by_name(PARAMETERS_CB_T *moudule, char *name, unsigned short *index, void *value)
+void Parameters_Reset_Stats(PARAMETERS_CB_T *moudule)
 {
-    PARAMETERS_CELL_T *cell = NULL;
-    unsigned char type = 0;
-
-    if (Parameters_Search(moudule, name, index))
-    {
-        cell = (PARAMETERS_CELL_T *)(moudule->block_start + (*index) * sizeof(PARAMETERS_CELL_T));
-        type = cell->type;
-        Parameters_Load_value(value, cell->data, cell->type);
-    }
-    return type;
-}
\ No newline at end of file
+#if PARAMETERS_STATS
+    OS_LOCK();
+    memset(&moudule->stats, 0, sizeof(PARAMETERS_STATS_T));
+    OS_UNLOCK();
+#else
+    (void)moudule;
+#endif
+}
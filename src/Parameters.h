@@ -19,13 +19,52 @@ extern "C"
 
 #define EMPTY_BYTE '\0'
 
+#ifndef ISR_LOCK
 #define ISR_LOCK()
 #define ISR_UNLOCK()
+#endif
 
+// writers always take OS_LOCK, readers only when the seqlock mode is off
+#ifndef OS_LOCK
 #define OS_LOCK()
 #define OS_UNLOCK()
+#endif
 
+// full memory barrier of the seqlock mode
+#ifndef PARAMETERS_BARRIER
+#define PARAMETERS_BARRIER() __sync_synchronize()
+#endif
 
+// deleted cells remembered for reuse by the tombstone delete mode, more are found by scanning RAM
+#define PARAMETERS_FREE_CACHE 8
+
+// changes of Parameters_Import announced one by one, a larger set announces every imported parameter
+#ifndef PARAMETERS_IMPORT_NOTIFY
+#define PARAMETERS_IMPORT_NOTIFY 32
+#endif
+
+// runtime counters kept in PARAMETERS_CB_T, the library and its users must agree on it
+#ifndef PARAMETERS_STATS
+#define PARAMETERS_STATS 0
+#endif
+
+// time source of the counters, such as a cycle counter register
+#ifndef PARAMETERS_STATS_CLOCK
+#define PARAMETERS_STATS_CLOCK() 0
+#endif
+
+// 32 bit check values in ROM and from checkout, changes the table information, the library and its users must agree on it
+#ifndef PARAMETERS_CHECK_32
+#define PARAMETERS_CHECK_32 0
+#endif
+
+
+
+#if PARAMETERS_CHECK_32
+    typedef unsigned int PARAMETERS_CHECK_T;
+#else
+    typedef unsigned short PARAMETERS_CHECK_T;
+#endif
 
     typedef enum
     {
@@ -46,10 +85,285 @@ extern "C"
     {
         char table_tag[16];
         unsigned short used_number;
-        unsigned short check_value;
+        PARAMETERS_CHECK_T check_value;
     } PARAMETERS_TABLE_INFO_T;
+
+    /**
+     * @description:                    Head of a snapshot made by Parameters_Export
+     * @note       :                    length bytes of entries follow, each one the 16 bytes of the identifier,
+     *                                  the type and the bytes of the value the type needs, sorted by identifier.
+     *                                  check_value is the checkout of the table over the entries.
+     */
+    typedef struct
+    {
+        unsigned int magic;
+        unsigned short number;
+        unsigned int length;
+        PARAMETERS_CHECK_T check_value;
+    } PARAMETERS_SNAPSHOT_T;
 #pragma pack()
 
+#define PARAMETERS_SNAPSHOT_MAGIC 0x50534E50
+
+// bytes of the identifier and the type before the value of a cell, as in the snapshot entries
+#define PARAMETERS_VALUE_OFFSET 17
+
+    typedef enum
+    {
+        PARAMETERS_CHECK_WHOLE = 0,     // checkout over the whole table, recomputed on every write
+        PARAMETERS_CHECK_INCREMENTAL,   // sum of the checkout of each cell, updated from the changed cell only
+    } PARAMETERS_CHECK_MODE_T;
+
+    /**
+     * @description:                    Subscription to changes of parameters, kept in PARAMETERS_CONFIG_T.subscription_block
+     * @note       :                    Filled by Parameters_Subscribe and Parameters_Subscribe_Handle
+     */
+    typedef struct
+    {
+        char name[16];        // identifier prefix, a whole identifier padded with '\0' for a handle
+        unsigned char length; // bytes of name compared, 0 matches every parameter
+        bool active;
+
+        /**
+         * @description:                    Called on every matching change
+         * @param       {void} *            context given to Parameters_Subscribe
+         * @param       {const char} *      identifier of the changed parameter
+         * @param       {unsigned} int      generation of the change
+         * @return      {*}
+         * @note       :                    Called under OS_LOCK after RAM changed, must not call the module
+         */
+        void (*notify)(void *, const char *, unsigned int);
+        void *context;
+
+        volatile unsigned int generation; // generation of the last matching change
+    } PARAMETERS_SUBSCRIPTION_T;
+
+    // entry of the change log, kept in PARAMETERS_CONFIG_T.change_log
+    typedef struct
+    {
+        unsigned int generation;
+        unsigned short index;
+    } PARAMETERS_LOG_T;
+
+    /**
+     * @description:                    A parameter changed since a generation, filled by Parameters_Get_Changes
+     * @note       :                    value holds the current value, as Parameters_Get_by_name copies it
+     */
+    typedef struct
+    {
+        unsigned int version;  // generation of the last change
+        unsigned short index;  // index for Parameters_Get_by_index
+        char name[17];
+        unsigned char type;
+        unsigned char value[8];
+    } PARAMETERS_CHANGE_T;
+
+    // counters since init or Parameters_Reset_Stats, times in PARAMETERS_STATS_CLOCK ticks
+    typedef struct
+    {
+        unsigned long lookups;        // Parameters_Search calls
+        unsigned long probes;         // cells or hash slots compared by the lookups, probes / lookups is the average
+        unsigned int max_probe;       // longest lookup
+        unsigned long read_calls;
+        unsigned long read_bytes;
+        unsigned long write_calls;
+        unsigned long write_bytes;
+        unsigned long retries;        // ROM calls repeated after a failed one
+        unsigned long failures;       // transfers given up after the last retry
+        unsigned long hashed_bytes;   // bytes passed to checkout
+        unsigned long read_time;
+        unsigned long write_time;
+        unsigned long checkout_time;
+    } PARAMETERS_STATS_T;
+
+    typedef struct
+    {
+        /**
+         * @description:                Open-addressing name index, NULL to search the table linearly
+         * @note       :                hash_size is the number of slots, must be a power of two and
+         *                              larger than the number of cells the RAM block can hold
+         */
+        unsigned short *hash_block;
+        unsigned int hash_size;
+
+        /**
+         * @description:                Identifiers of the cells copied into 16 byte slots, NULL to compare them in the cells
+         * @note       :                Needs Parameters_Offset_Count(size) slots at a 16 byte aligned address. The linear
+         *                              search then compares a whole identifier at once, with SSE2 or NEON when built
+         *                              for them. The cells keep their format. Not available with the lazy loading mode.
+         */
+        unsigned char (*name_block)[16];
+
+        /**
+         * @description:                Cell indexes sorted by identifier for Parameters_Find_Prefix, NULL disables them
+         * @note       :                Needs Parameters_Offset_Count(size) unsigned short. A creation or deletion moves
+         *                              the entries after its position. Lookups binary search it when there is no hash
+         *                              index. Not available with the lazy loading mode.
+         */
+        unsigned short *sort_map;
+
+        /**
+         * @description:                How check_value covers the table
+         * @note       :                Must stay the same for a table across boots
+         */
+        PARAMETERS_CHECK_MODE_T check_mode;
+
+        /**
+         * @description:                Dirty bitmap used by Parameters_Begin / Parameters_Commit, NULL disables batches
+         * @note       :                Needs Parameters_Dirty_Size(size) bytes
+         */
+        unsigned char *dirty_block;
+
+        /**
+         * @description:                Journal storage, 0 keeps the header and cells rewritten in place
+         * @note       :                The region of journal_size bytes from ROM_block is split into sectors of
+         *                              journal_sector bytes (at least 2, at most 255). Changes are appended as
+         *                              records, the oldest sector is compacted when the head sector fills up.
+         *                              journal_map needs one byte per cell of the RAM block.
+         */
+        unsigned int journal_size;
+        unsigned int journal_sector;
+        unsigned char *journal_map;
+
+        /**
+         * @description:                    Erase a ROM sector, NULL if the ROM is rewritable without erasing
+         * @param       {unsigned} int      The offset in ROM of the sector
+         * @param       {unsigned} int      The size of the sector
+         * @return      {*}                 Erase success or fail
+         * @note       :                    Erased bytes must read as 0xFF
+         */
+        bool (*Erase_ROM)(unsigned int, unsigned int);
+
+        /**
+         * @description:                Delete by marking the cell as a tombstone instead of moving the following cells
+         * @note       :                Parameters_Creat reuses tombstones, Parameters_Compact squeezes them out.
+         *                              index_map (one unsigned short per cell, optional) keeps Parameters_Get_by_index
+         *                              O(1) while tombstones exist. Not available with the journal storage.
+         */
+        bool tombstone;
+        unsigned short *index_map;
+
+        /**
+         * @description:                Largest Read_From_ROM transfer in bytes, 0 for no limit
+         * @note       :                Init loads the table in chunks of whole cells, a failed chunk is read cell by cell
+         */
+        unsigned int max_transfer;
+
+        /**
+         * @description:                Load cells a page of lazy_page cells at a time on first access, 0 to load all at init
+         * @note       :                page_check holds Parameters_Page_Count PARAMETERS_CHECK_T and page_loaded one bit per page.
+         *                              The page check values are kept in ROM right after the cells, check_value then covers
+         *                              them instead of the cells. Not available with the journal storage or tombstones.
+         */
+        unsigned short lazy_page;
+        PARAMETERS_CHECK_T *page_check;
+        unsigned char *page_loaded;
+
+        /**
+         * @description:                Packed cells, a value takes only the bytes of its type and 64 bit types are supported
+         * @note       :                offset_map holds Parameters_Offset_Count(size) unsigned short, the offset of every cell.
+         *                              A table of fixed size cells is converted at init. size is limited to 65535 bytes.
+         *                              Not available with the journal storage, tombstones or the lazy loading mode.
+         */
+        unsigned short *offset_map;
+
+        /**
+         * @description:                Readers never lock, they retry when a writer changed the table during the read
+         * @note       :                Writers still serialize with OS_LOCK and write ROM after the readers may go on.
+         *                              A reader spins while a writer changes RAM, it must not preempt that writer.
+         *                              Not available with the lazy loading mode.
+         */
+        bool seqlock;
+
+        /**
+         * @description:                Write-behind ring, changes update RAM and queue the cell for Parameters_Async_Drain
+         * @note       :                async_size is a power of two larger than Parameters_Offset_Count(size) + 1,
+         *                              Parameters_Hash_Slots(size) is enough. Needs dirty_block, which marks the queued
+         *                              cells: a cell changed again before it is written is queued once. Batches are off.
+         *                              Not available with the journal storage or the lazy loading mode.
+         */
+        unsigned short *async_ring;
+        unsigned int async_size;
+
+        /**
+         * @description:                Generation of the last change of every cell, NULL keeps only the table generation
+         * @note       :                Needs Parameters_Offset_Count(size) unsigned int. Versions move with their cells.
+         */
+        unsigned int *version_map;
+
+        /**
+         * @description:                Slots for Parameters_Subscribe, NULL disables subscriptions
+         * @note       :                Every change is matched against the active subscriptions
+         */
+        PARAMETERS_SUBSCRIPTION_T *subscription_block;
+        unsigned char subscription_size;
+
+        /**
+         * @description:                Ring of the last change_size changes for Parameters_Get_Changes, NULL disables it
+         * @note       :                change_size is a power of two. A deletion or Parameters_Compact moves cells,
+         *                              older generations then need a full resync. version_map drops superseded entries.
+         */
+        PARAMETERS_LOG_T *change_log;
+        unsigned short change_size;
+
+        /**
+         * @description:                Two images of the table in ROM, Parameters_Import writes the inactive one
+         * @note       :                Each image starts with a bank header written last, the valid one with the higher
+         *                              sequence is loaded at init. Takes Parameters_ROM_Size bytes, other changes are
+         *                              written in place to the active image. Not available with the journal storage,
+         *                              the lazy loading mode or the write-behind ring.
+         */
+        bool banks;
+
+        /**
+         * @description:                RAM_block already holds the cells as they are in ROM, such as the private mapping
+         *                              of a file given by Parameters_File_Map
+         * @note       :                Init checks the cells in place instead of clearing RAM and reading them, so pages
+         *                              stay shared with the file until a cell is written. RAM_block must be mapped again
+         *                              before every init. Not available with the journal storage, packed cells, the lazy
+         *                              loading mode or banks.
+         */
+        bool mapped;
+    } PARAMETERS_CONFIG_T;
+
+    /**
+     * @description:                    Direct reference to a parameter cell
+     * @note       :                    A handle goes stale when Parameters_Del moves cells,
+     *                                  stale handles are rejected and must be fetched again by name
+     */
+    typedef struct
+    {
+        unsigned short index;
+        unsigned short layout;
+    } PARAMETERS_HANDLE_T;
+
+    // a value of any type, the member is named after PARAMETERS_TYPE_T
+    typedef union
+    {
+        unsigned char UINT8;
+        signed char INT8;
+        unsigned short UINT16;
+        short INT16;
+        unsigned int UINT32;
+        int INT32;
+        unsigned long long UINT64;
+        long long INT64;
+        float F32;
+        double F64;
+    } PARAMETERS_VALUE_T;
+
+    /**
+     * @description:                    A parameter known at build time, see Parameters_table.h
+     * @note       :                    hash is the FNV-1a hash of the identifier as PARAMETERS_NAME_HASH computes it
+     */
+    typedef struct
+    {
+        const char *name;
+        PARAMETERS_TYPE_T type;
+        PARAMETERS_VALUE_T default_value;
+        unsigned int hash;
+    } PARAMETERS_ENTRY_T;
+
     typedef struct
     {
         unsigned char *block_start;
@@ -86,21 +400,132 @@ extern "C"
          * @return      {*}                 value of check
          * @note       :
          */
-        unsigned short (*checkout)(unsigned char *, unsigned int);
+        PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int);
+
+        PARAMETERS_CONFIG_T config;
+        unsigned short layout_version;
+
+        // batch state
+        unsigned char batch_depth;
+        unsigned int batch_pending; // ROM writes deferred by the open batch
+        unsigned int saved_writes;  // ROM writes avoided by coalescing, since power on
+
+        // tombstone state
+        unsigned short free_number;
+        unsigned short free_cache[PARAMETERS_FREE_CACHE];
+        unsigned char free_cached;
+        bool index_map_valid;
+
+        // sorted index state
+        unsigned short sort_number; // entries of sort_map
+
+        // journal state
+        unsigned int journal_sequence;
+        unsigned short journal_head;
+        unsigned short journal_slot;
+
+        // lazy loading state
+        bool page_dirty; // page check values changed by the open batch
+
+        // seqlock state, odd while a writer changes RAM
+        volatile unsigned int sequence;
+
+        // bumped by every change, the version of the changed cell
+        volatile unsigned int generation;
+
+        // change log state
+        unsigned int change_head;  // entries logged since init
+        unsigned int change_floor; // oldest generation a delta can start from
+
+        // write-behind state, running counts of queued records
+        volatile unsigned int async_head;    // queued by writers
+        volatile unsigned int async_tail;    // written to ROM
+        volatile unsigned int async_durable; // written and followed by the table information
+        volatile unsigned char async_info;   // a record of the table information alone is queued
+
+        // bank state
+        unsigned int bank_ROM;      // ROM_block, the offset of the first image
+        unsigned int bank_sequence; // sequence of the active image
+        unsigned char bank;         // active image, 0 or 1
+
+        /**
+         * @description:                    Task draining the ring, set after init by a port such as Parameters_posix.h
+         * @note       :                    Async_Notify is called under OS_LOCK when a record is queued,
+         *                                  Async_Wait blocks until async_durable reaches the count or the task stops
+         */
+        void *async_worker;
+        void (*Async_Notify)(void *);
+        bool (*Async_Wait)(void *, unsigned int);
 
+#if PARAMETERS_STATS
+        PARAMETERS_STATS_T stats;
+#endif
     } PARAMETERS_CB_T;
 
     bool Parameters_Init(PARAMETERS_CB_T *moudule, char *table_tag,
                          unsigned char *RAM_block, unsigned int ROM_block, unsigned int size,
                          bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
                          bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
-                         unsigned short (*checkout)(unsigned char *, unsigned int));
+                         PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int));
+    bool Parameters_Init_Ex(PARAMETERS_CB_T *moudule, char *table_tag,
+                            unsigned char *RAM_block, unsigned int ROM_block, unsigned int size,
+                            bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
+                            bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
+                            PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int),
+                            const PARAMETERS_CONFIG_T *config);
+    unsigned int Parameters_Hash_Slots(unsigned int size);
+    unsigned int Parameters_Dirty_Size(unsigned int size);
+    unsigned short Parameters_Page_Count(unsigned int size, unsigned short lazy_page);
+    unsigned int Parameters_Offset_Count(unsigned int size);
+    unsigned int Parameters_ROM_Size(unsigned int size, const PARAMETERS_CONFIG_T *config);
+    unsigned int Parameters_Used_Size(PARAMETERS_CB_T *moudule);
+    unsigned int Parameters_Hash_Name(const char *name);
 
     void *Parameters_Creat(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *default_value);
     void *Parameters_Chanege(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *value);
     bool Parameters_Del(PARAMETERS_CB_T *moudule, char *name);
     unsigned char Parameters_Get_by_index(PARAMETERS_CB_T *moudule, unsigned short index, char *name, void *value);
+    unsigned char Parameters_Get_Next(PARAMETERS_CB_T *moudule, unsigned short *cursor, char *name, void *value);
     unsigned char Parameters_Get_by_name(PARAMETERS_CB_T *moudule, char *name, unsigned short *index, void *value);
+    unsigned char Parameters_Find_Prefix(PARAMETERS_CB_T *moudule, const char *prefix, unsigned short *cursor, char *name,
+                                         void *value);
+    unsigned char Parameters_Find_Range(PARAMETERS_CB_T *moudule, const char *first, const char *last, unsigned short *cursor,
+                                        char *name, void *value);
+
+    bool Parameters_Creat_Handle(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_TYPE_T type, void *default_value,
+                                 PARAMETERS_HANDLE_T *handle);
+    bool Parameters_Get_Handle(PARAMETERS_CB_T *moudule, char *name, PARAMETERS_HANDLE_T *handle);
+    bool Parameters_Handle_Valid(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle);
+    void *Parameters_Handle_Data(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle);
+    bool Parameters_Handle_Name(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle, char *name);
+    bool Parameters_Set_by_handle(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle, PARAMETERS_TYPE_T type, void *value);
+    bool Parameters_Get_by_handle(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle, PARAMETERS_TYPE_T type, void *value);
+    bool Parameters_Register(PARAMETERS_CB_T *moudule, const PARAMETERS_ENTRY_T *entries, unsigned short number,
+                             PARAMETERS_HANDLE_T *handles);
+
+    bool Parameters_Begin(PARAMETERS_CB_T *moudule);
+    bool Parameters_Commit(PARAMETERS_CB_T *moudule);
+    bool Parameters_Compact(PARAMETERS_CB_T *moudule);
+
+    bool Parameters_Export(PARAMETERS_CB_T *moudule, unsigned char *buffer, unsigned int size, unsigned int *length);
+    bool Parameters_Import(PARAMETERS_CB_T *moudule, const unsigned char *snapshot, unsigned int length,
+                           unsigned short *applied);
+
+    bool Parameters_Async_Drain(PARAMETERS_CB_T *moudule);
+    bool Parameters_Flush(PARAMETERS_CB_T *moudule);
+
+    unsigned int Parameters_Generation(PARAMETERS_CB_T *moudule);
+    unsigned int Parameters_Version(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle);
+    bool Parameters_Subscribe(PARAMETERS_CB_T *moudule, const char *prefix,
+                              void (*notify)(void *, const char *, unsigned int), void *context, unsigned char *id);
+    bool Parameters_Subscribe_Handle(PARAMETERS_CB_T *moudule, PARAMETERS_HANDLE_T handle,
+                                     void (*notify)(void *, const char *, unsigned int), void *context, unsigned char *id);
+    bool Parameters_Unsubscribe(PARAMETERS_CB_T *moudule, unsigned char id);
+    unsigned int Parameters_Subscription_Generation(PARAMETERS_CB_T *moudule, unsigned char id);
+    bool Parameters_Get_Changes(PARAMETERS_CB_T *moudule, unsigned int since, PARAMETERS_CHANGE_T *changes, unsigned short size,
+                                unsigned short *number, unsigned int *until);
+    bool Parameters_Get_Stats(PARAMETERS_CB_T *moudule, PARAMETERS_STATS_T *stats);
+    void Parameters_Reset_Stats(PARAMETERS_CB_T *moudule);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,339 @@
+/*
+ * @Description    : Type safe C++ access to Parameters
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 18:02:37
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 18:02:37
+ * @FilePath       : \Parameters\src\Parameters.hpp
+ */
+
+#ifndef _PARAMETERS_HPP
+#define _PARAMETERS_HPP
+
+#include "Parameters.h"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace parameters
+{
+    /**
+     * @description:                    PARAMETERS_TYPE_T of a C++ type, other types do not compile
+     */
+    template <typename T>
+    struct ParamType;
+
+    template <>
+    struct ParamType<uint8_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_UINT8;
+    };
+    template <>
+    struct ParamType<int8_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_INT8;
+    };
+    template <>
+    struct ParamType<uint16_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_UINT16;
+    };
+    template <>
+    struct ParamType<int16_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_INT16;
+    };
+    template <>
+    struct ParamType<uint32_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_UINT32;
+    };
+    template <>
+    struct ParamType<int32_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_INT32;
+    };
+    template <>
+    struct ParamType<uint64_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_UINT64;
+    };
+    template <>
+    struct ParamType<int64_t>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_INT64;
+    };
+    template <>
+    struct ParamType<float>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_F32;
+    };
+    template <>
+    struct ParamType<double>
+    {
+        static const PARAMETERS_TYPE_T value = PARAMETERS_TYPE_F64;
+    };
+
+    /**
+     * @description:                    One parameter of type T
+     * @note       :                    Reads copy sizeof(T) bytes from the cell in RAM, the way a raw pointer returned
+     *                                  by Parameters_Creat is read, after an inline check of the layout of the handle
+     *                                  and of the identifier of the cell, under OS_LOCK or the seqlock like the C readers.
+     *                                  Every read costs that lock or one seqlock round with two barriers.
+     *                                  A cell moved by a delete or Parameters_Compact is found again by identifier,
+     *                                  a deleted one reads as the default value.
+     */
+    template <typename T>
+    class Param
+    {
+    public:
+        Param() : moudule_(NULL), name_(NULL), data_(NULL), default_value_()
+        {
+            handle_.index = 0;
+            handle_.layout = 0;
+        }
+
+        /**
+         * @description:                Create the parameter or take the existing one
+         * @param       {PARAMETERS_CB_T} *moudule  Pointer to the parameter management modules
+         * @param       {char} *name                identifier, must outlive the Param
+         * @param       {T} default_value           value of a new parameter
+         * @note       :                ok() is false if the table is full or holds the identifier with another type
+         */
+        Param(PARAMETERS_CB_T *moudule, const char *name, T default_value)
+            : moudule_(moudule), name_(name), data_(NULL), default_value_(default_value)
+        {
+            if (Parameters_Creat_Handle(moudule, const_cast<char *>(name), ParamType<T>::value, &default_value, &handle_))
+            {
+                data_ = static_cast<unsigned char *>(Parameters_Handle_Data(moudule, handle_));
+            }
+        }
+
+        bool ok() const
+        {
+            return data_ != NULL;
+        }
+
+        /**
+         * @description:                Read the value
+         * @param       {T} &value      value of the parameter
+         * @return      {*}             false once the parameter is deleted
+         */
+        bool read(T &value) const
+        {
+            unsigned int sequence = 0;
+            bool fresh;
+
+            while (data_ != NULL)
+            {
+                if (moudule_->config.seqlock)
+                {
+                    do
+                    {
+                        sequence = moudule_->sequence;
+                    } while (sequence & 1);
+                    PARAMETERS_BARRIER();
+                }
+                else
+                {
+                    OS_LOCK();
+                }
+
+                // a move changes the layout and a tombstone delete empties the identifier, either is looked up again
+                fresh = handle_.layout == moudule_->layout_version && data_[-PARAMETERS_VALUE_OFFSET] != EMPTY_BYTE;
+                if (fresh)
+                {
+                    memcpy(&value, data_, sizeof(T));
+                }
+
+                if (moudule_->config.seqlock)
+                {
+                    PARAMETERS_BARRIER();
+                    if (moudule_->sequence != sequence)
+                    {
+                        continue;
+                    }
+                }
+                else
+                {
+                    OS_UNLOCK();
+                }
+
+                if (fresh)
+                {
+                    return true;
+                }
+                refresh();
+            }
+            return false;
+        }
+
+        /**
+         * @description:                Value of the parameter, the default value once it is deleted
+         */
+        T get() const
+        {
+            T value;
+            return read(value) ? value : default_value_;
+        }
+
+        operator T() const
+        {
+            return get();
+        }
+
+        /**
+         * @description:                Change the value and write it to ROM
+         * @param       {T} value
+         * @return      {*}             success or fail
+         */
+        bool set(T value)
+        {
+            if (data_ == NULL)
+            {
+                return false;
+            }
+            if (Parameters_Set_by_handle(moudule_, handle_, ParamType<T>::value, &value))
+            {
+                return true;
+            }
+            return !Parameters_Handle_Valid(moudule_, handle_) && refresh() &&
+                   Parameters_Set_by_handle(moudule_, handle_, ParamType<T>::value, &value);
+        }
+
+        Param &operator=(T value)
+        {
+            set(value);
+            return *this;
+        }
+
+        PARAMETERS_HANDLE_T handle() const
+        {
+            return handle_;
+        }
+
+    private:
+        // the layout changed, look the cell up again
+        bool refresh() const
+        {
+            T value;
+
+            data_ = NULL;
+            if (Parameters_Get_Handle(moudule_, const_cast<char *>(name_), &handle_))
+            {
+                data_ = static_cast<unsigned char *>(Parameters_Handle_Data(moudule_, handle_));
+                if (data_ != NULL && !Parameters_Get_by_handle(moudule_, handle_, ParamType<T>::value, &value))
+                {
+                    data_ = NULL;
+                }
+            }
+            return data_ != NULL;
+        }
+
+        PARAMETERS_CB_T *moudule_;
+        const char *name_;
+        mutable PARAMETERS_HANDLE_T handle_;
+        mutable unsigned char *data_;
+        T default_value_;
+    };
+
+    /**
+     * @description:                    Changes between construction and destruction are written to ROM together
+     * @note       :                    Parameters_Begin / Parameters_Commit, nothing is deferred without a dirty block
+     */
+    class Batch
+    {
+    public:
+        explicit Batch(PARAMETERS_CB_T *moudule) : moudule_(moudule), open_(Parameters_Begin(moudule))
+        {
+        }
+
+        ~Batch()
+        {
+            commit();
+        }
+
+        /**
+         * @description:                Write the changes now instead of at destruction
+         * @return      {*}             success or fail
+         */
+        bool commit()
+        {
+            bool status = true;
+
+            if (open_)
+            {
+                open_ = false;
+                status = Parameters_Commit(moudule_);
+            }
+            return status;
+        }
+
+    private:
+        Batch(const Batch &);
+        Batch &operator=(const Batch &);
+
+        PARAMETERS_CB_T *moudule_;
+        bool open_;
+    };
+
+    /**
+     * @description:                    A table with typed access by identifier
+     * @note       :                    The table is initialized by the caller with Parameters_Init_Ex
+     */
+    class ParamTable
+    {
+    public:
+        explicit ParamTable(PARAMETERS_CB_T *moudule) : moudule_(moudule)
+        {
+        }
+
+        PARAMETERS_CB_T *moudule() const
+        {
+            return moudule_;
+        }
+
+        template <typename T>
+        Param<T> param(const char *name, T default_value) const
+        {
+            return Param<T>(moudule_, name, default_value);
+        }
+
+        /**
+         * @description:                Read a parameter by identifier
+         * @param       {char} *name    identifier
+         * @param       {T} &value      value of the parameter
+         * @return      {*}             false if there is none or it has another type
+         */
+        template <typename T>
+        bool get(const char *name, T &value) const
+        {
+            PARAMETERS_VALUE_T temp;
+            unsigned short index;
+
+            if (Parameters_Get_by_name(moudule_, const_cast<char *>(name), &index, &temp) != ParamType<T>::value)
+            {
+                return false;
+            }
+            memcpy(&value, &temp, sizeof(T));
+            return true;
+        }
+
+        /**
+         * @description:                Change a parameter by identifier
+         * @param       {char} *name    identifier
+         * @param       {T} value
+         * @return      {*}             false if there is none or it has another type
+         */
+        template <typename T>
+        bool set(const char *name, T value) const
+        {
+            return Parameters_Chanege(moudule_, const_cast<char *>(name), ParamType<T>::value, &value) != NULL;
+        }
+
+    private:
+        PARAMETERS_CB_T *moudule_;
+    };
+} // namespace parameters
+
+#endif //_PARAMETERS_HPP
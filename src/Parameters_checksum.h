@@ -0,0 +1,30 @@
+/*
+ * @Description    : Checkout functions shipped with the library
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 22:12:37
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 22:12:37
+ * @FilePath       : \Parameters\src\Parameters_checksum.h
+ */
+
+#ifndef _PARAMETERS_CHECKSUM_H
+#define _PARAMETERS_CHECKSUM_H
+
+#include "Parameters.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+    unsigned int Parameters_CRC32C(unsigned int crc, const unsigned char *data, unsigned int size);
+    unsigned int Parameters_CRC32C_Slice8(unsigned int crc, const unsigned char *data, unsigned int size);
+    bool Parameters_CRC32C_Hardware(void);
+
+    PARAMETERS_CHECK_T Parameters_Checkout_CRC32C(unsigned char *data, unsigned int size);
+    PARAMETERS_CHECK_T Parameters_Checkout_Sum(unsigned char *data, unsigned int size);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif //_PARAMETERS_CHECKSUM_H
@@ -0,0 +1,406 @@
+/*
+ * @Description    : Tables keeping only identifier hashes in RAM
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 21:04:52
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 21:04:52
+ * @FilePath       : \Parameters\src\Parameters_lean.c
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "Parameters_lean.h"
+
+// bytes of a cell in ROM: identifier, type and value
+#define PARAMETERS_LEAN_ROM_CELL 21
+
+// cells read at once by the init
+#define PARAMETERS_LEAN_CHUNK 8
+
+// type of a cell deleted in the tombstone mode
+#define PARAMETERS_LEAN_TOMBSTONE 0xFF
+
+/**
+ * @description:                                Bytes taken by a value of a type
+ * @param       {unsigned char} type            PARAMETERS_TYPE_T
+ * @return      {*}                             1, 2 or 4, 0 for a type a cell cannot hold
+ * @note       :
+ */
+static unsigned char Parameters_Lean_Width(unsigned char type)
+{
+    switch (type)
+    {
+    case PARAMETERS_TYPE_UINT8:
+    case PARAMETERS_TYPE_INT8:
+        return 1;
+    case PARAMETERS_TYPE_UINT16:
+    case PARAMETERS_TYPE_INT16:
+        return 2;
+    case PARAMETERS_TYPE_UINT32:
+    case PARAMETERS_TYPE_INT32:
+    case PARAMETERS_TYPE_F32:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @description:                                Read or write bytes of the table in ROM
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {unsigned char} operate         type of operate <1> RAM to ROM   <2> ROM to RAM
+ * @param       {unsigned char} *data           bytes in RAM
+ * @param       {unsigned int} offset           offset from the table information
+ * @param       {unsigned int} size             number of bytes
+ * @return      {*}                             success or fail
+ * @note       :                                Retried like the SYNC functions of the tables
+ */
+static bool Parameters_Lean_SYNC(PARAMETERS_LEAN_T *moudule, unsigned char operate, unsigned char *data,
+                                 unsigned int offset, unsigned int size)
+{
+    unsigned char max_retry = 4;
+
+    while (max_retry)
+    {
+        if (operate == 1 ? moudule->Write_2_ROM(data, moudule->ROM_start_offset + offset, size)
+                         : moudule->Read_From_ROM(data, moudule->ROM_start_offset + offset, size))
+        {
+            return true;
+        }
+        max_retry--;
+    }
+
+    printf("Parameters 0X%x SYNC lean offset:%d failed! type %d\n", (uintptr_t)moudule, offset, operate);
+    return false;
+}
+
+/**
+ * @description:                                Offset of a cell from the table information
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}
+ * @note       :
+ */
+static unsigned int Parameters_Lean_Offset(unsigned short index)
+{
+    return sizeof(PARAMETERS_TABLE_INFO_T) + index * PARAMETERS_LEAN_ROM_CELL;
+}
+
+/**
+ * @description:                                Build the ROM image of a cell
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {unsigned short} index          index of cell
+ * @param       {char} *key                     identifier padded with '\0' to 16 bytes
+ * @param       {unsigned char} *cell           PARAMETERS_LEAN_ROM_CELL bytes
+ * @return      {*}                             checkout of the cell
+ * @note       :
+ */
+static PARAMETERS_CHECK_T Parameters_Lean_Cell(PARAMETERS_LEAN_T *moudule, unsigned short index, const char *key,
+                                               unsigned char *cell)
+{
+    memcpy(cell, key, 16);
+    cell[16] = moudule->type[index];
+    memcpy(cell + 17, moudule->data[index], 4);
+    return moudule->checkout(cell, PARAMETERS_LEAN_ROM_CELL);
+}
+
+/**
+ * @description:                                Find the cell of an identifier
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {char} *key                     filled with the identifier padded with '\0' to 16 bytes
+ * @param       {unsigned short} *index         index of the cell, used_number if there is none
+ * @return      {*}                             found or not
+ * @note       :                                A cell of the same hash is only taken once its identifier in ROM
+ *                                              is the same, a collision goes on to the next one
+ */
+static bool Parameters_Lean_Find(PARAMETERS_LEAN_T *moudule, char *name, char *key, unsigned short *index)
+{
+    unsigned int hash = Parameters_Hash_Name(name);
+    char stored[16];
+
+    memset(key, EMPTY_BYTE, 16);
+    strncpy(key, name, 16);
+    for (*index = 0; name[0] != EMPTY_BYTE && memchr(name, EMPTY_BYTE, 17) != NULL && *index < moudule->table_info.used_number;
+         (*index)++)
+    {
+        if (moudule->hash[*index] == hash &&
+            Parameters_Lean_SYNC(moudule, 2, (unsigned char *)stored, Parameters_Lean_Offset(*index), 16) &&
+            memcmp(stored, key, 16) == 0)
+        {
+            return true;
+        }
+    }
+    *index = moudule->table_info.used_number;
+    return false;
+}
+
+/**
+ * @description:                                Write a changed cell and the table information to ROM
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {unsigned char} *cell           ROM image of the cell
+ * @param       {unsigned short} index          index of cell
+ * @return      {*}                             success or fail
+ * @note       :
+ */
+static bool Parameters_Lean_Commit(PARAMETERS_LEAN_T *moudule, unsigned char *cell, unsigned short index)
+{
+    return Parameters_Lean_SYNC(moudule, 1, cell, Parameters_Lean_Offset(index), PARAMETERS_LEAN_ROM_CELL) &&
+           Parameters_Lean_SYNC(moudule, 1, (unsigned char *)&moudule->table_info, 0, sizeof(PARAMETERS_TABLE_INFO_T));
+}
+
+/**
+ * @description:                                Bytes of RAM a lean table needs
+ * @param       {unsigned int} size             Size of the parameter table in ROM, as given to Parameters_Init
+ * @return      {*}                             PARAMETERS_LEAN_CELL_SIZE bytes per cell the table holds
+ * @note       :                                The RAM block must be aligned for an unsigned int
+ */
+unsigned int Parameters_Lean_Size(unsigned int size)
+{
+    return size != 0 ? (size - 1) / PARAMETERS_LEAN_ROM_CELL * PARAMETERS_LEAN_CELL_SIZE : 0;
+}
+
+/**
+ * @description:                                Initialize a table keeping only identifier hashes in RAM
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {char} *table_tag               String identifier. Must end with '\0' and be no longer than 16
+ * @param       {unsigned char} *RAM_block      Parameters_Lean_Size(size) bytes of RAM
+ * @param       {unsigned int} ROM_block        Offset address of a storage block allocated in ROM
+ * @param       {unsigned int} size             Size of the parameter table in ROM, in bytes
+ * @param       {bool char} Read_From_ROM       Funtion of read data from ROM
+ * @param       {bool} Write_2_ROM              Funtion of write data to ROM
+ * @param       {PARAMETERS_CHECK_T} checkout   Funtion of data checkout
+ * @return      {*}                             success or fail
+ * @note       :                                The cells are read PARAMETERS_LEAN_CHUNK at a time, hashed and checked
+ *                                              against the table information, their identifiers are not kept
+ */
+bool Parameters_Lean_Init(PARAMETERS_LEAN_T *moudule, char *table_tag,
+                          unsigned char *RAM_block, unsigned int ROM_block, unsigned int size,
+                          bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
+                          bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
+                          PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int))
+{
+    unsigned char chunk[PARAMETERS_LEAN_CHUNK * PARAMETERS_LEAN_ROM_CELL];
+    unsigned char *cell;
+    PARAMETERS_CHECK_T check = 0;
+    unsigned short index = 0;
+    unsigned short number, count;
+
+    moudule->capacity = Parameters_Lean_Size(size) / PARAMETERS_LEAN_CELL_SIZE;
+    moudule->hash = (unsigned int *)RAM_block;
+    moudule->data = (unsigned char(*)[4])(RAM_block + moudule->capacity * sizeof(unsigned int));
+    moudule->type = RAM_block + moudule->capacity * (sizeof(unsigned int) + 4);
+    moudule->free_number = 0;
+    moudule->ROM_start_offset = ROM_block;
+    moudule->Read_From_ROM = Read_From_ROM;
+    moudule->Write_2_ROM = Write_2_ROM;
+    moudule->checkout = checkout;
+    memset(RAM_block, EMPTY_BYTE, Parameters_Lean_Size(size));
+
+    if (!Parameters_Lean_SYNC(moudule, 2, (unsigned char *)&moudule->table_info, 0, sizeof(PARAMETERS_TABLE_INFO_T)))
+    {
+        return false;
+    }
+
+    if (strncmp(moudule->table_info.table_tag, table_tag, 16) != 0)
+    {
+        // This is a whole new memory area that needs to write new information
+        memset(moudule->table_info.table_tag, EMPTY_BYTE, 16);
+        strncpy(moudule->table_info.table_tag, table_tag, 16);
+        moudule->table_info.used_number = 0;
+        moudule->table_info.check_value = 0;
+        return Parameters_Lean_SYNC(moudule, 1, (unsigned char *)&moudule->table_info, 0, sizeof(PARAMETERS_TABLE_INFO_T));
+    }
+
+    if (moudule->table_info.used_number > moudule->capacity)
+    {
+        printf("Parameters 0X%x checkout error!\n", (uintptr_t)moudule);
+        moudule->table_info.used_number = 0;
+        return false;
+    }
+
+    while (index < moudule->table_info.used_number)
+    {
+        number = moudule->table_info.used_number - index < PARAMETERS_LEAN_CHUNK ? moudule->table_info.used_number - index
+                                                                                 : PARAMETERS_LEAN_CHUNK;
+        if (!Parameters_Lean_SYNC(moudule, 2, chunk, Parameters_Lean_Offset(index), number * PARAMETERS_LEAN_ROM_CELL))
+        {
+            moudule->table_info.used_number = index;
+            return false;
+        }
+        for (count = 0, cell = chunk; count < number; count++, index++, cell += PARAMETERS_LEAN_ROM_CELL)
+        {
+            check += checkout(cell, PARAMETERS_LEAN_ROM_CELL);
+            moudule->type[index] = cell[16];
+            memcpy(moudule->data[index], cell + 17, 4);
+            if (cell[0] == EMPTY_BYTE)
+            {
+                moudule->free_number++;
+            }
+            else
+            {
+                moudule->hash[index] = Parameters_Hash_Name((char *)cell);
+            }
+        }
+    }
+
+    if (check != moudule->table_info.check_value)
+    {
+        printf("Parameters 0X%x checkout error!\n", (uintptr_t)moudule);
+        memset(RAM_block, EMPTY_BYTE, Parameters_Lean_Size(size));
+        moudule->table_info.used_number = 0;
+        moudule->free_number = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @description:                                Create a parameter, or take the existing one of the identifier
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {PARAMETERS_TYPE_T} type
+ * @param       {void} *default_value           Address default value.
+ * @return      {*}                             Address of value.
+ * @note       :                                If no identifier is found and there is no space left to create a cell, NULL is returned.
+ */
+void *Parameters_Lean_Creat(PARAMETERS_LEAN_T *moudule, char *name, PARAMETERS_TYPE_T type, void *default_value)
+{
+    unsigned char cell[PARAMETERS_LEAN_ROM_CELL];
+    void *ret = NULL;
+    unsigned short index;
+    char key[16];
+
+    OS_LOCK();
+
+    if (Parameters_Lean_Find(moudule, name, key, &index))
+    {
+        ret = moudule->data[index];
+    }
+    else if (Parameters_Lean_Width(type) == 0 || name[0] == EMPTY_BYTE)
+    {
+        printf("Parameters %s type error\n", name);
+    }
+    else if (index >= moudule->capacity)
+    {
+        printf("Parameters 0X%x without space\n", (uintptr_t)moudule);
+    }
+    else
+    {
+        moudule->hash[index] = Parameters_Hash_Name(name);
+        moudule->type[index] = type;
+        memset(moudule->data[index], EMPTY_BYTE, 4);
+        memcpy(moudule->data[index], default_value, Parameters_Lean_Width(type));
+        moudule->table_info.used_number++;
+        moudule->table_info.check_value += Parameters_Lean_Cell(moudule, index, key, cell);
+        Parameters_Lean_Commit(moudule, cell, index);
+        ret = moudule->data[index];
+    }
+
+    OS_UNLOCK();
+    return ret;
+}
+
+/**
+ * @description:                                Change the value of the parameter
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {char} *name                    String identifier. Must end with '\0' and be no longer than 17
+ * @param       {PARAMETERS_TYPE_T} type        type of the parameter
+ * @param       {void} *value                   Address of value.
+ * @return      {*}                             Address of value.
+ * @note       :                                If the corresponding identifier is not found, NULL is returned.
+ */
+void *Parameters_Lean_Chanege(PARAMETERS_LEAN_T *moudule, char *name, PARAMETERS_TYPE_T type, void *value)
+{
+    unsigned char cell[PARAMETERS_LEAN_ROM_CELL];
+    void *ret = NULL;
+    unsigned short index;
+    char key[16];
+
+    OS_LOCK();
+
+    if (Parameters_Lean_Find(moudule, name, key, &index) && moudule->type[index] == type)
+    {
+        moudule->table_info.check_value -= Parameters_Lean_Cell(moudule, index, key, cell);
+        memcpy(moudule->data[index], value, Parameters_Lean_Width(type));
+        moudule->table_info.check_value += Parameters_Lean_Cell(moudule, index, key, cell);
+        Parameters_Lean_Commit(moudule, cell, index);
+        ret = moudule->data[index];
+    }
+
+    OS_UNLOCK();
+    return ret;
+}
+
+/**
+ * @description:                                Read the parameter of an identifier
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {char} *name                    identifier of the parameter
+ * @param       {unsigned short} *index         index for Parameters_Lean_Get_by_index
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 if there is none
+ * @note       :                                Reads the identifier of every cell of the same hash from ROM
+ */
+unsigned char Parameters_Lean_Get_by_name(PARAMETERS_LEAN_T *moudule, char *name, unsigned short *index, void *value)
+{
+    unsigned char type = 0;
+    unsigned short slot;
+    char key[16];
+
+    OS_LOCK();
+
+    if (Parameters_Lean_Find(moudule, name, key, index))
+    {
+        type = moudule->type[*index];
+        memcpy(value, moudule->data[*index], Parameters_Lean_Width(type));
+
+        // the index given by Parameters_Lean_Get_by_index does not count deleted cells
+        for (slot = *index; moudule->free_number != 0 && slot != 0; slot--)
+        {
+            *index -= moudule->type[slot - 1] == PARAMETERS_LEAN_TOMBSTONE;
+        }
+    }
+
+    OS_UNLOCK();
+    return type;
+}
+
+/**
+ * @description:                                Get the identifier of the parameter based on the index
+ * @param       {PARAMETERS_LEAN_T} *moudule    Pointer to the parameter management modules
+ * @param       {unsigned short} index          index
+ * @param       {char} *name                    16 bytes, the identifier of the parameter read from ROM
+ * @param       {void} *value                   value of parameter
+ * @return      {*}                             type of the parameter, 0 if there is none
+ * @note       :
+ */
+unsigned char Parameters_Lean_Get_by_index(PARAMETERS_LEAN_T *moudule, unsigned short index, char *name, void *value)
+{
+    unsigned char type = 0;
+    unsigned short slot = index;
+
+    OS_LOCK();
+
+    // deleted cells are skipped, indexes stay dense
+    if (moudule->free_number != 0)
+    {
+        for (slot = 0; slot < moudule->table_info.used_number; slot++)
+        {
+            if (moudule->type[slot] != PARAMETERS_LEAN_TOMBSTONE && index-- == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    if (slot < moudule->table_info.used_number &&
+        Parameters_Lean_SYNC(moudule, 2, (unsigned char *)name, Parameters_Lean_Offset(slot), 16))
+    {
+        type = moudule->type[slot];
+        memcpy(value, moudule->data[slot], Parameters_Lean_Width(type));
+    }
+
+    OS_UNLOCK();
+    return type;
+}
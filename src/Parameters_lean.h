@@ -0,0 +1,59 @@
+/*
+ * @Description    : Tables keeping only identifier hashes in RAM
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 21:04:52
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 21:04:52
+ * @FilePath       : \Parameters\src\Parameters_lean.h
+ */
+
+#ifndef _PARAMETERS_LEAN_H
+#define _PARAMETERS_LEAN_H
+
+#include "Parameters.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+// bytes of RAM per parameter: hash of the identifier, value and type
+#define PARAMETERS_LEAN_CELL_SIZE 9
+
+    /**
+     * @description:                    A table whose identifiers stay in ROM
+     * @note       :                    The ROM format is the one of a Parameters_Init_Ex table of the same size in the
+     *                                  PARAMETERS_CHECK_INCREMENTAL check mode, either can open the table of the other.
+     *                                  Values are limited to 32 bit types as in fixed size cells.
+     */
+    typedef struct
+    {
+        unsigned int *hash;         // Parameters_Hash_Name of the identifier of every cell
+        unsigned char (*data)[4];   // value of every cell
+        unsigned char *type;        // type of every cell
+        unsigned short capacity;    // cells the ROM region holds
+        unsigned short free_number; // deleted cells of a table written in the tombstone mode
+
+        unsigned int ROM_start_offset;
+        PARAMETERS_TABLE_INFO_T table_info;
+
+        bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int);
+        bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int);
+        PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int);
+    } PARAMETERS_LEAN_T;
+
+    unsigned int Parameters_Lean_Size(unsigned int size);
+    bool Parameters_Lean_Init(PARAMETERS_LEAN_T *moudule, char *table_tag,
+                              unsigned char *RAM_block, unsigned int ROM_block, unsigned int size,
+                              bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
+                              bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
+                              PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int));
+    void *Parameters_Lean_Creat(PARAMETERS_LEAN_T *moudule, char *name, PARAMETERS_TYPE_T type, void *default_value);
+    void *Parameters_Lean_Chanege(PARAMETERS_LEAN_T *moudule, char *name, PARAMETERS_TYPE_T type, void *value);
+    unsigned char Parameters_Lean_Get_by_name(PARAMETERS_LEAN_T *moudule, char *name, unsigned short *index, void *value);
+    unsigned char Parameters_Lean_Get_by_index(PARAMETERS_LEAN_T *moudule, unsigned short index, char *name, void *value);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif //_PARAMETERS_LEAN_H
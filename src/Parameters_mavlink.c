@@ -0,0 +1,409 @@
+/*
+ * @Description    : MAVLink parameter protocol messages of Parameters
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 15:42:18
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 15:42:18
+ * @FilePath       : \Parameters\src\Parameters_mavlink.c
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "Parameters_mavlink.h"
+
+/**
+ * @description:                                Bytes taken by a value of a type
+ * @param       {unsigned char} type            PARAMETERS_TYPE_T
+ * @return      {*}                             1, 2, 4 or 8, 0 for an unknown type
+ * @note       :
+ */
+static unsigned char Parameters_Mavlink_Width(unsigned char type)
+{
+    switch (type)
+    {
+    case PARAMETERS_TYPE_UINT8:
+    case PARAMETERS_TYPE_INT8:
+        return 1;
+    case PARAMETERS_TYPE_UINT16:
+    case PARAMETERS_TYPE_INT16:
+        return 2;
+    case PARAMETERS_TYPE_UINT32:
+    case PARAMETERS_TYPE_INT32:
+    case PARAMETERS_TYPE_F32:
+        return 4;
+    case PARAMETERS_TYPE_UINT64:
+    case PARAMETERS_TYPE_INT64:
+    case PARAMETERS_TYPE_F64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @description:                                Convert a value to float
+ * @param       {unsigned char} *raw            value in the layout of its type
+ * @param       {unsigned char} type            PARAMETERS_TYPE_T
+ * @return      {*}
+ * @note       :
+ */
+static float Parameters_Mavlink_To_Float(const unsigned char *raw, unsigned char type)
+{
+    union
+    {
+        uint8_t u8;
+        int8_t i8;
+        uint16_t u16;
+        int16_t i16;
+        uint32_t u32;
+        int32_t i32;
+        uint64_t u64;
+        int64_t i64;
+        float f32;
+        double f64;
+    } value;
+
+    memcpy(&value, raw, Parameters_Mavlink_Width(type));
+    switch (type)
+    {
+    case PARAMETERS_TYPE_UINT8:
+        return value.u8;
+    case PARAMETERS_TYPE_INT8:
+        return value.i8;
+    case PARAMETERS_TYPE_UINT16:
+        return value.u16;
+    case PARAMETERS_TYPE_INT16:
+        return value.i16;
+    case PARAMETERS_TYPE_UINT32:
+        return (float)value.u32;
+    case PARAMETERS_TYPE_INT32:
+        return (float)value.i32;
+    case PARAMETERS_TYPE_UINT64:
+        return (float)value.u64;
+    case PARAMETERS_TYPE_INT64:
+        return (float)value.i64;
+    case PARAMETERS_TYPE_F32:
+        return value.f32;
+    case PARAMETERS_TYPE_F64:
+        return (float)value.f64;
+    default:
+        return 0.0f;
+    }
+}
+
+/**
+ * @description:                                Round a float into the range of an integer type
+ * @param       {float} value                   received value
+ * @param       {double} min                    smallest value of the type
+ * @param       {double} max                    largest value of the type
+ * @return      {*}
+ * @note       :
+ */
+static double Parameters_Mavlink_Clamp(float value, double min, double max)
+{
+    double rounded = value < 0 ? (double)value - 0.5 : (double)value + 0.5;
+
+    if (rounded <= min)
+    {
+        return min;
+    }
+    if (rounded >= max)
+    {
+        return max;
+    }
+    return rounded;
+}
+
+/**
+ * @description:                                Convert a float to a value of a type
+ * @param       {float} value                   received value
+ * @param       {unsigned char} type            PARAMETERS_TYPE_T
+ * @param       {unsigned char} *raw            value in the layout of its type
+ * @return      {*}
+ * @note       :                                Integers are rounded and saturated
+ */
+static void Parameters_Mavlink_From_Float(float value, unsigned char type, unsigned char *raw)
+{
+    union
+    {
+        uint8_t u8;
+        int8_t i8;
+        uint16_t u16;
+        int16_t i16;
+        uint32_t u32;
+        int32_t i32;
+        uint64_t u64;
+        int64_t i64;
+        float f32;
+        double f64;
+    } cast;
+
+    switch (type)
+    {
+    case PARAMETERS_TYPE_UINT8:
+        cast.u8 = (uint8_t)Parameters_Mavlink_Clamp(value, 0, UINT8_MAX);
+        break;
+    case PARAMETERS_TYPE_INT8:
+        cast.i8 = (int8_t)Parameters_Mavlink_Clamp(value, INT8_MIN, INT8_MAX);
+        break;
+    case PARAMETERS_TYPE_UINT16:
+        cast.u16 = (uint16_t)Parameters_Mavlink_Clamp(value, 0, UINT16_MAX);
+        break;
+    case PARAMETERS_TYPE_INT16:
+        cast.i16 = (int16_t)Parameters_Mavlink_Clamp(value, INT16_MIN, INT16_MAX);
+        break;
+    case PARAMETERS_TYPE_UINT32:
+        cast.u32 = (uint32_t)Parameters_Mavlink_Clamp(value, 0, UINT32_MAX);
+        break;
+    case PARAMETERS_TYPE_INT32:
+        cast.i32 = (int32_t)Parameters_Mavlink_Clamp(value, INT32_MIN, INT32_MAX);
+        break;
+    case PARAMETERS_TYPE_UINT64:
+        // the largest double below 2^64 and -2^63 both convert exactly
+        cast.u64 = (uint64_t)Parameters_Mavlink_Clamp(value, 0, 18446744073709549568.0);
+        break;
+    case PARAMETERS_TYPE_INT64:
+        cast.i64 = (int64_t)Parameters_Mavlink_Clamp(value, -9223372036854775808.0, 9223372036854774784.0);
+        break;
+    case PARAMETERS_TYPE_F32:
+        cast.f32 = value;
+        break;
+    case PARAMETERS_TYPE_F64:
+        cast.f64 = value;
+        break;
+    default:
+        return;
+    }
+    memcpy(raw, &cast, Parameters_Mavlink_Width(type));
+}
+
+/**
+ * @description:                                Store a value of up to 4 bytes into a little-endian field of 4 bytes
+ * @param       {unsigned char} *field          4 bytes of the payload
+ * @param       {unsigned char} *raw            value in the layout of its type on the host
+ * @param       {unsigned char} width           1, 2 or 4
+ * @return      {*}
+ * @note       :                                Narrow values are zero extended
+ */
+static void Parameters_Mavlink_Store(unsigned char *field, const unsigned char *raw, unsigned char width)
+{
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32 = 0;
+
+    if (width == 1)
+    {
+        memcpy(&u8, raw, 1);
+        u32 = u8;
+    }
+    else if (width == 2)
+    {
+        memcpy(&u16, raw, 2);
+        u32 = u16;
+    }
+    else if (width == 4)
+    {
+        memcpy(&u32, raw, 4);
+    }
+    field[0] = u32 & 0xFF;
+    field[1] = (u32 >> 8) & 0xFF;
+    field[2] = (u32 >> 16) & 0xFF;
+    field[3] = u32 >> 24;
+}
+
+/**
+ * @description:                                Load a value of up to 4 bytes from a little-endian field of 4 bytes
+ * @param       {unsigned char} *field          4 bytes of the payload
+ * @param       {unsigned char} *raw            value in the layout of its type on the host
+ * @param       {unsigned char} width           1, 2 or 4
+ * @return      {*}
+ * @note       :                                The bytes above the width are dropped
+ */
+static void Parameters_Mavlink_Load(const unsigned char *field, unsigned char *raw, unsigned char width)
+{
+    uint32_t u32 = field[0] | (uint32_t)field[1] << 8 | (uint32_t)field[2] << 16 | (uint32_t)field[3] << 24;
+    uint8_t u8 = (uint8_t)u32;
+    uint16_t u16 = (uint16_t)u32;
+
+    if (width == 1)
+    {
+        memcpy(raw, &u8, 1);
+    }
+    else if (width == 2)
+    {
+        memcpy(raw, &u16, 2);
+    }
+    else if (width == 4)
+    {
+        memcpy(raw, &u32, 4);
+    }
+}
+
+/**
+ * @description:                                Fill the fields of a PARAM_VALUE payload around its identifier
+ * @param       {PARAMETERS_MAVLINK_ENCODE_T} encode  encoding of the value field
+ * @param       {unsigned char} type            PARAMETERS_TYPE_T of the parameter
+ * @param       {unsigned char} *raw            value in the layout of its type
+ * @param       {unsigned short} index          index of the parameter, as Parameters_Get_by_index
+ * @param       {unsigned short} count          param_count to send
+ * @param       {unsigned char} *payload        PARAMETERS_MAVLINK_VALUE_LEN bytes, param_id already written
+ * @return      {*}
+ * @note       :
+ */
+static void Parameters_Mavlink_Encode(PARAMETERS_MAVLINK_ENCODE_T encode, unsigned char type, const unsigned char *raw,
+                                      unsigned short index, unsigned short count, unsigned char *payload)
+{
+    float value;
+
+    if (encode == PARAMETERS_MAVLINK_BYTEWISE && Parameters_Mavlink_Width(type) <= 4)
+    {
+        Parameters_Mavlink_Store(payload, raw, Parameters_Mavlink_Width(type));
+    }
+    else
+    {
+        value = Parameters_Mavlink_To_Float(raw, type);
+        Parameters_Mavlink_Store(payload, (unsigned char *)&value, 4);
+    }
+    payload[4] = count & 0xFF;
+    payload[5] = count >> 8;
+    payload[6] = index & 0xFF;
+    payload[7] = index >> 8;
+    payload[24] = type;
+}
+
+/**
+ * @description:                                Encode the PARAM_VALUE payload of a parameter
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_MAVLINK_ENCODE_T} encode  encoding of the value field
+ * @param       {unsigned short} index          index of the parameter, as Parameters_Get_by_index
+ * @param       {unsigned short} count          param_count to send
+ * @param       {unsigned char} *payload        PARAMETERS_MAVLINK_VALUE_LEN bytes
+ * @return      {*}                             type of the parameter, 0 if there is none and nothing was written
+ * @note       :                                The identifier is copied from RAM straight into the payload.
+ *                                              Multi-byte fields are stored little-endian, as on the wire.
+ */
+unsigned char Parameters_Mavlink_Value(PARAMETERS_CB_T *moudule, PARAMETERS_MAVLINK_ENCODE_T encode,
+                                       unsigned short index, unsigned short count, unsigned char *payload)
+{
+    unsigned char raw[8];
+    unsigned char type;
+
+    type = Parameters_Get_by_index(moudule, index, (char *)payload + 8, raw);
+    if (type != 0)
+    {
+        Parameters_Mavlink_Encode(encode, type, raw, index, count, payload);
+    }
+    return type;
+}
+
+/**
+ * @description:                                Start answering PARAM_REQUEST_LIST
+ * @param       {PARAMETERS_MAVLINK_STREAM_T} *stream  cursor of the answer
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_MAVLINK_ENCODE_T} encode  encoding of the value field
+ * @return      {*}
+ * @note       :                                param_count is taken now and kept for the whole answer
+ */
+void Parameters_Mavlink_Start(PARAMETERS_MAVLINK_STREAM_T *stream, PARAMETERS_CB_T *moudule, PARAMETERS_MAVLINK_ENCODE_T encode)
+{
+    stream->moudule = moudule;
+    stream->encode = encode;
+    stream->index = 0;
+    stream->cursor = 0;
+    stream->count = moudule->table_info.used_number - moudule->free_number;
+}
+
+/**
+ * @description:                                Write the next PARAM_VALUE payloads of the answer
+ * @param       {PARAMETERS_MAVLINK_STREAM_T} *stream  cursor of the answer
+ * @param       {unsigned char} *buffer         TX buffer, payloads are written back to back
+ * @param       {unsigned int} budget           bytes available in buffer
+ * @return      {*}                             bytes written, a multiple of PARAMETERS_MAVLINK_VALUE_LEN
+ * @note       :                                Call again with the next buffer until Parameters_Mavlink_Done.
+ *                                              A table that shrank meanwhile ends the answer early.
+ */
+unsigned int Parameters_Mavlink_Stream(PARAMETERS_MAVLINK_STREAM_T *stream, unsigned char *buffer, unsigned int budget)
+{
+    unsigned int size = 0;
+    unsigned char raw[8];
+    unsigned char type;
+
+    while (stream->index < stream->count && budget - size >= PARAMETERS_MAVLINK_VALUE_LEN)
+    {
+        // the cursor steps over tombstones, no parameter is looked up by its index
+        type = Parameters_Get_Next(stream->moudule, &stream->cursor, (char *)buffer + size + 8, raw);
+        if (type == 0)
+        {
+            stream->index = stream->count;
+            break;
+        }
+        Parameters_Mavlink_Encode(stream->encode, type, raw, stream->index, stream->count, buffer + size);
+        stream->index++;
+        size += PARAMETERS_MAVLINK_VALUE_LEN;
+    }
+    return size;
+}
+
+/**
+ * @description:                                Check whether the answer is complete
+ * @param       {PARAMETERS_MAVLINK_STREAM_T} *stream  cursor of the answer
+ * @return      {*}
+ * @note       :
+ */
+bool Parameters_Mavlink_Done(PARAMETERS_MAVLINK_STREAM_T *stream)
+{
+    return stream->index >= stream->count;
+}
+
+/**
+ * @description:                                Apply a PARAM_SET and encode the PARAM_VALUE answering it
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {PARAMETERS_MAVLINK_ENCODE_T} encode  encoding of the value field
+ * @param       {unsigned char} *payload        received PARAM_SET payload
+ * @param       {unsigned char} length          received bytes, a truncated payload is extended with zeros
+ * @param       {unsigned char} *reply          PARAMETERS_MAVLINK_VALUE_LEN bytes for the answer
+ * @return      {*}                             false if the parameter does not exist or was not changed
+ * @note       :                                The value is stored with the type of the parameter, the type field
+ *                                              of the message is not trusted. Target ids are left to the caller.
+ */
+bool Parameters_Mavlink_Set(PARAMETERS_CB_T *moudule, PARAMETERS_MAVLINK_ENCODE_T encode,
+                            const unsigned char *payload, unsigned char length, unsigned char *reply)
+{
+    unsigned char message[PARAMETERS_MAVLINK_SET_LEN];
+    unsigned char raw[8];
+    unsigned short index;
+    unsigned char type;
+    char name[17];
+    float value;
+
+    memset(message, 0, sizeof(message));
+    memcpy(message, payload, length < sizeof(message) ? length : sizeof(message));
+    memset(name, EMPTY_BYTE, sizeof(name));
+    memcpy(name, message + 6, 16);
+
+    type = Parameters_Get_by_name(moudule, name, &index, raw);
+    if (type == 0)
+    {
+        printf("Parameters %s not found\n", name);
+        return false;
+    }
+
+    memset(raw, 0, sizeof(raw));
+    if (encode == PARAMETERS_MAVLINK_BYTEWISE && Parameters_Mavlink_Width(type) <= 4)
+    {
+        Parameters_Mavlink_Load(message, raw, Parameters_Mavlink_Width(type));
+    }
+    else
+    {
+        Parameters_Mavlink_Load(message, (unsigned char *)&value, 4);
+        Parameters_Mavlink_From_Float(value, type, raw);
+    }
+
+    if (Parameters_Chanege(moudule, name, (PARAMETERS_TYPE_T)type, raw) == NULL)
+    {
+        return false;
+    }
+    return Parameters_Mavlink_Value(moudule, encode, index, moudule->table_info.used_number - moudule->free_number, reply) != 0;
+}
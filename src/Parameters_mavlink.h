@@ -0,0 +1,56 @@
+/*
+ * @Description    : MAVLink parameter protocol messages of Parameters
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 15:42:18
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 15:42:18
+ * @FilePath       : \Parameters\src\Parameters_mavlink.h
+ */
+
+#ifndef _PARAMETERS_MAVLINK_H
+#define _PARAMETERS_MAVLINK_H
+
+#include "Parameters.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+// payload sizes, MAVLink 2 may truncate trailing zero bytes of a received payload
+#define PARAMETERS_MAVLINK_VALUE_LEN 25 // PARAM_VALUE: float value, uint16 count, uint16 index, char id[16], uint8 type
+#define PARAMETERS_MAVLINK_SET_LEN 23   // PARAM_SET: float value, uint8 target system, uint8 target component, char id[16], uint8 type
+
+    /**
+     * @description:                    How a value travels in the float field of the messages
+     * @note       :                    PARAMETERS_TYPE_T numbers the types as MAV_PARAM_TYPE does.
+     *                                  64 bit values do not fit the field and are always converted.
+     */
+    typedef enum
+    {
+        PARAMETERS_MAVLINK_BYTEWISE = 0, // the bytes of the value, MAV_PROTOCOL_CAPABILITY_PARAM_ENCODE_BYTEWISE
+        PARAMETERS_MAVLINK_C_CAST,       // the value converted to float, MAV_PROTOCOL_CAPABILITY_PARAM_ENCODE_C_CAST
+    } PARAMETERS_MAVLINK_ENCODE_T;
+
+    // answer to PARAM_REQUEST_LIST, resumable across calls
+    typedef struct
+    {
+        PARAMETERS_CB_T *moudule;
+        PARAMETERS_MAVLINK_ENCODE_T encode;
+        unsigned short index; // next parameter to send
+        unsigned short cursor; // next cell of Parameters_Get_Next
+        unsigned short count; // param_count of the whole answer
+    } PARAMETERS_MAVLINK_STREAM_T;
+
+    unsigned char Parameters_Mavlink_Value(PARAMETERS_CB_T *moudule, PARAMETERS_MAVLINK_ENCODE_T encode,
+                                           unsigned short index, unsigned short count, unsigned char *payload);
+    void Parameters_Mavlink_Start(PARAMETERS_MAVLINK_STREAM_T *stream, PARAMETERS_CB_T *moudule, PARAMETERS_MAVLINK_ENCODE_T encode);
+    unsigned int Parameters_Mavlink_Stream(PARAMETERS_MAVLINK_STREAM_T *stream, unsigned char *buffer, unsigned int budget);
+    bool Parameters_Mavlink_Done(PARAMETERS_MAVLINK_STREAM_T *stream);
+    bool Parameters_Mavlink_Set(PARAMETERS_CB_T *moudule, PARAMETERS_MAVLINK_ENCODE_T encode,
+                                const unsigned char *payload, unsigned char length, unsigned char *reply);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif //_PARAMETERS_MAVLINK_H
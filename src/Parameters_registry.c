@@ -0,0 +1,708 @@
+/*
+ * @Description    : Tables sharing one ROM region
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 19:10:26
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 19:10:26
+ * @FilePath       : \Parameters\src\Parameters_registry.c
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Parameters_registry.h"
+
+#define PARAMETERS_REGISTRY_NONE 0xFF
+
+// bytes cleared at the start of a new region, and of each journal sector, covering the table tag
+#define PARAMETERS_REGISTRY_HEAD 32
+
+/**
+ * @description:                                Read or write ROM of the registry region
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {unsigned char} operate         type of operate <1> RAM to ROM   <2> ROM to RAM
+ * @param       {unsigned char} *data           bytes in RAM
+ * @param       {unsigned int} offset           offset from the start of the registry region
+ * @param       {unsigned int} size             number of bytes
+ * @return      {*}                             success or fail
+ * @note       :                                Retried like the SYNC functions of the tables
+ */
+static bool Parameters_Registry_SYNC(PARAMETERS_REGISTRY_T *registry, unsigned char operate, unsigned char *data,
+                                     unsigned int offset, unsigned int size)
+{
+    unsigned char max_retry = 4;
+
+    while (max_retry)
+    {
+        if (operate == 1 ? registry->Write_2_ROM(data, registry->ROM_start_offset + offset, size)
+                         : registry->Read_From_ROM(data, registry->ROM_start_offset + offset, size))
+        {
+            return true;
+        }
+        max_retry--;
+    }
+
+    printf("Parameters 0X%x SYNC registry failed! type %d\n", (uintptr_t)registry, operate);
+    return false;
+}
+
+/**
+ * @description:                                Check value of a copy of the directory
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {PARAMETERS_REGISTRY_INFO_T} *info  head of the copy
+ * @return      {*}                             checkout of the head up to the check value and of the records
+ * @note       :
+ */
+static PARAMETERS_CHECK_T Parameters_Registry_Check(PARAMETERS_REGISTRY_T *registry, PARAMETERS_REGISTRY_INFO_T *info)
+{
+    return registry->checkout((unsigned char *)info, offsetof(PARAMETERS_REGISTRY_INFO_T, check_value)) ^
+           registry->checkout((unsigned char *)registry->records, info->number * sizeof(PARAMETERS_REGISTRY_RECORD_T));
+}
+
+/**
+ * @description:                                Write the directory to the copy not holding the current one
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @return      {*}                             success or fail
+ * @note       :                                The head is written after the records, a copy torn by a reset fails its
+ *                                              check and the other copy stays current
+ */
+static bool Parameters_Registry_Save(PARAMETERS_REGISTRY_T *registry)
+{
+    unsigned int offset;
+
+    registry->info.sequence++;
+    registry->info.check_value = Parameters_Registry_Check(registry, &registry->info);
+    offset = (registry->info.sequence & 1) * registry->directory_size;
+
+    if (Parameters_Registry_SYNC(registry, 1, (unsigned char *)registry->records, offset + sizeof(PARAMETERS_REGISTRY_INFO_T),
+                                 registry->info.number * sizeof(PARAMETERS_REGISTRY_RECORD_T)) &&
+        Parameters_Registry_SYNC(registry, 1, (unsigned char *)&registry->info, offset, sizeof(PARAMETERS_REGISTRY_INFO_T)))
+    {
+        return true;
+    }
+    registry->info.sequence--;
+    return false;
+}
+
+/**
+ * @description:                                Load one copy of the directory
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {PARAMETERS_REGISTRY_INFO_T} *info  head of the copy, already read
+ * @param       {unsigned char} bank            0 or 1
+ * @return      {*}                             false if the copy is not valid
+ * @note       :
+ */
+static bool Parameters_Registry_Load(PARAMETERS_REGISTRY_T *registry, PARAMETERS_REGISTRY_INFO_T *info, unsigned char bank)
+{
+    if (strncmp(info->registry_tag, registry->info.registry_tag, 16) != 0 || info->number > registry->capacity ||
+        !Parameters_Registry_SYNC(registry, 2, (unsigned char *)registry->records,
+                                  bank * registry->directory_size + sizeof(PARAMETERS_REGISTRY_INFO_T),
+                                  info->number * sizeof(PARAMETERS_REGISTRY_RECORD_T)) ||
+        Parameters_Registry_Check(registry, info) != info->check_value)
+    {
+        return false;
+    }
+    registry->info = *info;
+    return true;
+}
+
+/**
+ * @description:                                Record of a table
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {char} *table_tag               String identifier of the table
+ * @return      {*}                             number of the record, PARAMETERS_REGISTRY_NONE if there is none
+ * @note       :
+ */
+static unsigned char Parameters_Registry_Record(PARAMETERS_REGISTRY_T *registry, const char *table_tag)
+{
+    unsigned char count;
+
+    for (count = 0; count < registry->info.number; count++)
+    {
+        if (strncmp(registry->records[count].table_tag, table_tag, 16) == 0)
+        {
+            return count;
+        }
+    }
+    return PARAMETERS_REGISTRY_NONE;
+}
+
+/**
+ * @description:                                Check that a region is free
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {unsigned int} offset           start of the region from the start of the registry region
+ * @param       {unsigned int} size             bytes of the region
+ * @param       {unsigned char} skip            record ignored, the one of a table resized in place
+ * @return      {*}                             the region is inside the registry region and overlaps no other table
+ * @note       :
+ */
+static bool Parameters_Registry_Free_At(PARAMETERS_REGISTRY_T *registry, unsigned int offset, unsigned int size, unsigned char skip)
+{
+    PARAMETERS_REGISTRY_RECORD_T *record;
+    unsigned char count;
+
+    if (offset < 2 * registry->directory_size || offset + size > registry->ROM_size || offset + size < offset)
+    {
+        return false;
+    }
+    for (count = 0; count < registry->info.number; count++)
+    {
+        record = &registry->records[count];
+        if (count != skip && offset < record->offset + record->ROM_size && record->offset < offset + size)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @description:                                Start of a region after the directory or after a table
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {unsigned char} after           record the region follows, PARAMETERS_REGISTRY_NONE for the directory
+ * @return      {*}                             offset rounded up to the sector
+ * @note       :
+ */
+static unsigned int Parameters_Registry_Start(PARAMETERS_REGISTRY_T *registry, unsigned char after)
+{
+    unsigned int start = 2 * registry->directory_size;
+
+    if (after != PARAMETERS_REGISTRY_NONE)
+    {
+        start = registry->records[after].offset + registry->records[after].ROM_size;
+    }
+    return (start + registry->sector - 1) / registry->sector * registry->sector;
+}
+
+/**
+ * @description:                                Find the lowest free region of a size
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {unsigned int} size             bytes of ROM needed
+ * @param       {unsigned int} *offset          start of the region
+ * @return      {*}                             false without space
+ * @note       :                                First fit, a region starts after the directory or after another table.
+ *                                              The region of a table being moved stays taken until the move is done.
+ */
+static bool Parameters_Registry_Place(PARAMETERS_REGISTRY_T *registry, unsigned int size, unsigned int *offset)
+{
+    unsigned int start;
+    unsigned char count = PARAMETERS_REGISTRY_NONE;
+    bool found = false;
+
+    do
+    {
+        start = Parameters_Registry_Start(registry, count);
+        if ((!found || start < *offset) && Parameters_Registry_Free_At(registry, start, size, PARAMETERS_REGISTRY_NONE))
+        {
+            *offset = start;
+            found = true;
+        }
+        count++;
+    } while (count < registry->info.number);
+
+    return found;
+}
+
+/**
+ * @description:                                Add the cells of a table to the global index
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {unsigned char} table           record of the table
+ * @param       {unsigned short} from           first cell to add
+ * @return      {*}                             false if the index is full
+ * @note       :
+ */
+static bool Parameters_Registry_Index_Table(PARAMETERS_REGISTRY_T *registry, unsigned char table, unsigned short from)
+{
+    PARAMETERS_CB_T *moudule = registry->tables[table].moudule;
+    PARAMETERS_HANDLE_T handle;
+    unsigned int mask = registry->slot_size - 1;
+    unsigned int hash, slot, probe;
+    char name[17];
+
+    handle.layout = moudule->layout_version;
+    for (handle.index = from; handle.index < moudule->table_info.used_number; handle.index++)
+    {
+        if (!Parameters_Handle_Name(moudule, handle, name))
+        {
+            continue;
+        }
+
+        hash = Parameters_Hash_Name(name);
+        slot = hash & mask;
+        for (probe = 0; probe < registry->slot_size && registry->slots[slot].table != 0; probe++)
+        {
+            slot = (slot + 1) & mask;
+        }
+        if (probe == registry->slot_size)
+        {
+            return false;
+        }
+        registry->slots[slot].hash = hash;
+        registry->slots[slot].index = handle.index;
+        registry->slots[slot].table = table + 1;
+    }
+    return true;
+}
+
+/**
+ * @description:                                Bring the global index up to date with the open tables
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @return      {*}                             false if the index cannot hold every parameter until it is rebuilt
+ * @note       :                                Parameters created at the end of a table are added, any other change of
+ *                                              the cells of a table, a delete or a compaction, rebuilds the index
+ */
+static bool Parameters_Registry_Index(PARAMETERS_REGISTRY_T *registry)
+{
+    PARAMETERS_REGISTRY_TABLE_T *table;
+    PARAMETERS_CB_T *moudule;
+    bool status = true;
+    unsigned char count;
+
+    for (count = 0; registry->index_valid && count < registry->info.number; count++)
+    {
+        table = &registry->tables[count];
+        moudule = table->moudule;
+        if (moudule != NULL && (table->layout != moudule->layout_version || table->free_number != moudule->free_number ||
+                                table->used_number > moudule->table_info.used_number))
+        {
+            registry->index_valid = false;
+        }
+    }
+
+    if (!registry->index_valid)
+    {
+        memset(registry->slots, 0, registry->slot_size * sizeof(PARAMETERS_REGISTRY_SLOT_T));
+        for (count = 0; count < registry->info.number; count++)
+        {
+            registry->tables[count].layout = 0;
+            registry->tables[count].used_number = 0;
+            registry->tables[count].free_number = 0;
+        }
+        registry->index_valid = true;
+        registry->index_full = false;
+    }
+
+    for (count = 0; count < registry->info.number; count++)
+    {
+        table = &registry->tables[count];
+        moudule = table->moudule;
+        if (moudule == NULL)
+        {
+            continue;
+        }
+        if (table->used_number < moudule->table_info.used_number || table->layout != moudule->layout_version)
+        {
+            status = status && Parameters_Registry_Index_Table(registry, count, table->used_number);
+            table->layout = moudule->layout_version;
+            table->used_number = moudule->table_info.used_number;
+            table->free_number = moudule->free_number;
+        }
+    }
+
+    if (!status)
+    {
+        printf("Parameters 0X%x registry index full!\n", (uintptr_t)registry);
+        registry->index_full = true;
+    }
+    return !registry->index_full;
+}
+
+/**
+ * @description:                                Initialize a registry
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {char} *registry_tag            String identifier. Must end with '\0' and be no longer than 16
+ * @param       {unsigned int} ROM_block        Offset address of the ROM region shared by the tables
+ * @param       {unsigned int} size             Size of the ROM region, in bytes
+ * @param       {unsigned int} sector           regions start on multiples of it, 0 or 1 packs them
+ * @param       {PARAMETERS_REGISTRY_RECORD_T} *records     capacity records
+ * @param       {PARAMETERS_REGISTRY_TABLE_T} *tables       capacity tables
+ * @param       {unsigned char} capacity        tables the registry can hold
+ * @param       {PARAMETERS_REGISTRY_SLOT_T} *slots         global index, NULL searches every table
+ * @param       {unsigned int} slot_size        power of two, larger than twice the parameters of all tables
+ * @param       {bool char} Read_From_ROM       Funtion of read data from ROM
+ * @param       {bool} Write_2_ROM              Funtion of write data to ROM
+ * @param       {PARAMETERS_CHECK_T} checkout   Funtion of data checkout
+ * @return      {*}                             success or fail
+ * @note       :                                Two copies of the directory start the region, the tables follow.
+ *                                              A region without a valid directory starts empty.
+ */
+bool Parameters_Registry_Init(PARAMETERS_REGISTRY_T *registry, char *registry_tag, unsigned int ROM_block,
+                              unsigned int size, unsigned int sector, PARAMETERS_REGISTRY_RECORD_T *records,
+                              PARAMETERS_REGISTRY_TABLE_T *tables, unsigned char capacity,
+                              PARAMETERS_REGISTRY_SLOT_T *slots, unsigned int slot_size,
+                              bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
+                              bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
+                              PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int))
+{
+    PARAMETERS_REGISTRY_INFO_T info[2];
+    bool valid[2];
+    unsigned char bank;
+
+    registry->ROM_start_offset = ROM_block;
+    registry->ROM_size = size;
+    registry->sector = sector == 0 ? 1 : sector;
+    registry->directory_size = sizeof(PARAMETERS_REGISTRY_INFO_T) + capacity * sizeof(PARAMETERS_REGISTRY_RECORD_T);
+    registry->directory_size = (registry->directory_size + registry->sector - 1) / registry->sector * registry->sector;
+    registry->records = records;
+    registry->tables = tables;
+    registry->capacity = capacity == PARAMETERS_REGISTRY_NONE ? capacity - 1 : capacity;
+    registry->slots = slots;
+    registry->slot_size = slot_size;
+    registry->index_valid = false;
+    registry->index_full = false;
+    registry->Read_From_ROM = Read_From_ROM;
+    registry->Write_2_ROM = Write_2_ROM;
+    registry->checkout = checkout;
+
+    memset(tables, 0, capacity * sizeof(PARAMETERS_REGISTRY_TABLE_T));
+    memset(&registry->info, EMPTY_BYTE, sizeof(PARAMETERS_REGISTRY_INFO_T));
+    strncpy(registry->info.registry_tag, registry_tag, 16);
+
+    if (2 * registry->directory_size > size || (slots != NULL && (slot_size == 0 || (slot_size & (slot_size - 1)) != 0)))
+    {
+        printf("Parameters 0X%x registry size error!\n", (uintptr_t)registry);
+        return false;
+    }
+
+    for (bank = 0; bank < 2; bank++)
+    {
+        valid[bank] = Parameters_Registry_SYNC(registry, 2, (unsigned char *)&info[bank], bank * registry->directory_size,
+                                               sizeof(PARAMETERS_REGISTRY_INFO_T));
+    }
+
+    // the newer copy first, the other one if a reset tore it
+    bank = valid[1] && (!valid[0] || (int)(info[1].sequence - info[0].sequence) > 0);
+    if ((valid[bank] && Parameters_Registry_Load(registry, &info[bank], bank)) ||
+        (valid[!bank] && Parameters_Registry_Load(registry, &info[!bank], !bank)))
+    {
+        return true;
+    }
+
+    // This is a whole new region that needs an empty directory
+    registry->info.sequence = 0;
+    registry->info.number = 0;
+    return Parameters_Registry_Save(registry);
+}
+
+/**
+ * @description:                                Open a table of the registry, giving it a region the first time
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules
+ * @param       {char} *table_tag               String identifier of the table, names its region
+ * @param       {unsigned char} *RAM_block      Address of a storage block allocated in RAM
+ * @param       {unsigned int} size             Size of the parameter table to manage , in bytes
+ * @param       {PARAMETERS_CONFIG_T} *config   Optional features, NULL behaves as Parameters_Init
+ * @return      {*}                             success or fail
+ * @note       :                                A table grown since its region was given is moved or extended with
+ *                                              Parameters_Registry_Resize, a smaller size fails as the cells may not fit
+ */
+bool Parameters_Registry_Open(PARAMETERS_REGISTRY_T *registry, PARAMETERS_CB_T *moudule, char *table_tag,
+                              unsigned char *RAM_block, unsigned int size, const PARAMETERS_CONFIG_T *config)
+{
+    PARAMETERS_REGISTRY_RECORD_T *record;
+    unsigned char header[PARAMETERS_REGISTRY_HEAD];
+    unsigned char number = Parameters_Registry_Record(registry, table_tag);
+    unsigned int need = Parameters_ROM_Size(size, config);
+    unsigned int offset, step, count;
+    bool status = true;
+
+    if (number == PARAMETERS_REGISTRY_NONE)
+    {
+        if (registry->info.number >= registry->capacity || !Parameters_Registry_Place(registry, need, &offset))
+        {
+            printf("Parameters 0X%x registry without space for %s\n", (uintptr_t)registry, table_tag);
+            return false;
+        }
+
+        // a removed table may have left its cells in the region, they must not be loaded
+        memset(header, EMPTY_BYTE, sizeof(header));
+        step = config != NULL && config->journal_size != 0 ? config->journal_sector : need;
+        for (count = 0; status && count < need; count += step)
+        {
+            status = Parameters_Registry_SYNC(registry, 1, header, offset + count,
+                                              need - count < sizeof(header) ? need - count : sizeof(header));
+        }
+
+        number = registry->info.number;
+        record = &registry->records[number];
+        memset(record->table_tag, EMPTY_BYTE, 16);
+        strncpy(record->table_tag, table_tag, 16);
+        record->offset = offset;
+        record->ROM_size = need;
+        record->size = size;
+        registry->info.number++;
+        if (!status || !Parameters_Registry_Save(registry))
+        {
+            registry->info.number--;
+            return false;
+        }
+    }
+
+    record = &registry->records[number];
+    if (record->size > size)
+    {
+        printf("Parameters 0X%x registry table %s larger than its RAM block\n", (uintptr_t)registry, table_tag);
+        return false;
+    }
+
+    registry->tables[number].moudule = NULL;
+    registry->index_valid = false;
+    if (!Parameters_Init_Ex(moudule, table_tag, RAM_block, registry->ROM_start_offset + record->offset, record->size,
+                            registry->Read_From_ROM, registry->Write_2_ROM, registry->checkout, config))
+    {
+        return false;
+    }
+    registry->tables[number].moudule = moudule;
+
+    if (record->size < size)
+    {
+        return Parameters_Registry_Resize(registry, moudule, RAM_block, size, config);
+    }
+    return true;
+}
+
+/**
+ * @description:                                Change the size of an open table
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {PARAMETERS_CB_T} *moudule      table opened with Parameters_Registry_Open
+ * @param       {unsigned char} *RAM_block      Address of a storage block of the new size, may be the current one
+ *                                              when it is large enough
+ * @param       {unsigned int} size             new size of the parameter table, in bytes
+ * @param       {PARAMETERS_CONFIG_T} *config   Optional features suited to the new size
+ * @return      {*}                             success or fail, the table is left as it was on failure
+ * @note       :                                The region is extended or shrunk in place when the next table leaves room,
+ *                                              otherwise the cells are copied to a free region. Only this table is
+ *                                              written, the directory update is the point the new region takes over.
+ *                                              Journal, lazy loading, write-behind, bank and mapped tables keep their size.
+ */
+bool Parameters_Registry_Resize(PARAMETERS_REGISTRY_T *registry, PARAMETERS_CB_T *moudule,
+                                unsigned char *RAM_block, unsigned int size, const PARAMETERS_CONFIG_T *config)
+{
+    PARAMETERS_REGISTRY_RECORD_T *record, old;
+    PARAMETERS_CONFIG_T old_config = moudule->config;
+    unsigned char *old_RAM = moudule->block_start;
+    unsigned int need = Parameters_ROM_Size(size, config);
+    unsigned int used = Parameters_Used_Size(moudule);
+    unsigned int offset, copied, chunk;
+    unsigned char number;
+    char table_tag[17];
+    bool status = true;
+
+    for (number = 0; number < registry->info.number && registry->tables[number].moudule != moudule; number++)
+    {
+    }
+    if (number == registry->info.number)
+    {
+        printf("Parameters 0X%x registry table 0X%x not open\n", (uintptr_t)registry, (uintptr_t)moudule);
+        return false;
+    }
+
+    if (moudule->config.journal_size != 0 || moudule->config.lazy_page != 0 || moudule->config.async_ring != NULL ||
+        moudule->config.banks || moudule->config.mapped ||
+        (config != NULL && (config->journal_size != 0 || config->lazy_page != 0 || config->async_ring != NULL ||
+                            config->banks || config->mapped)) ||
+        moudule->batch_depth != 0 || used >= size)
+    {
+        printf("Parameters 0X%x registry resize error!\n", (uintptr_t)moudule);
+        return false;
+    }
+
+    record = &registry->records[number];
+    old = *record;
+    memcpy(table_tag, record->table_tag, 16);
+    table_tag[16] = EMPTY_BYTE;
+
+    offset = old.offset;
+    if (!Parameters_Registry_Free_At(registry, offset, need, number))
+    {
+        if (!Parameters_Registry_Place(registry, need, &offset))
+        {
+            printf("Parameters 0X%x registry without space for %s\n", (uintptr_t)registry, table_tag);
+            return false;
+        }
+
+        // table information and cells to the new region, through the new RAM block
+        for (copied = 0; status && copied < sizeof(PARAMETERS_TABLE_INFO_T) + used; copied += chunk)
+        {
+            chunk = sizeof(PARAMETERS_TABLE_INFO_T) + used - copied < size ? sizeof(PARAMETERS_TABLE_INFO_T) + used - copied : size;
+            status = Parameters_Registry_SYNC(registry, 2, RAM_block, old.offset + copied, chunk) &&
+                     Parameters_Registry_SYNC(registry, 1, RAM_block, offset + copied, chunk);
+        }
+    }
+
+    status = status && Parameters_Init_Ex(moudule, table_tag, RAM_block, registry->ROM_start_offset + offset, size,
+                                          registry->Read_From_ROM, registry->Write_2_ROM, registry->checkout, config);
+    if (status)
+    {
+        record->offset = offset;
+        record->ROM_size = need;
+        record->size = size;
+        status = Parameters_Registry_Save(registry);
+        if (!status)
+        {
+            *record = old;
+        }
+    }
+
+    if (!status)
+    {
+        Parameters_Init_Ex(moudule, table_tag, old_RAM, registry->ROM_start_offset + old.offset, old.size,
+                           registry->Read_From_ROM, registry->Write_2_ROM, registry->checkout, &old_config);
+    }
+    registry->index_valid = false;
+    return status;
+}
+
+/**
+ * @description:                                Give the region of a table back to the registry
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {char} *table_tag               String identifier of the table
+ * @return      {*}                             false if there is no such table
+ * @note       :                                The cells stay in ROM until another table takes the region
+ */
+bool Parameters_Registry_Remove(PARAMETERS_REGISTRY_T *registry, char *table_tag)
+{
+    PARAMETERS_REGISTRY_RECORD_T record;
+    PARAMETERS_REGISTRY_TABLE_T table;
+    unsigned char number = Parameters_Registry_Record(registry, table_tag);
+    unsigned char last = registry->info.number - 1;
+
+    if (number == PARAMETERS_REGISTRY_NONE)
+    {
+        return false;
+    }
+
+    record = registry->records[number];
+    table = registry->tables[number];
+    registry->records[number] = registry->records[last];
+    registry->tables[number] = registry->tables[last];
+    registry->tables[last].moudule = NULL;
+    registry->info.number--;
+    registry->index_valid = false;
+
+    if (!Parameters_Registry_Save(registry))
+    {
+        registry->info.number++;
+        registry->records[last] = registry->records[number];
+        registry->tables[last] = registry->tables[number];
+        registry->records[number] = record;
+        registry->tables[number] = table;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @description:                                Look an identifier up in the global index
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {char} *name                    String identifier
+ * @param       {unsigned int} hash             Parameters_Hash_Name of the identifier
+ * @param       {PARAMETERS_CB_T} **moudule     table holding the parameter
+ * @param       {PARAMETERS_HANDLE_T} *handle   Handle of the cell
+ * @return      {*}                             false if no slot leads to a cell with the identifier
+ * @note       :                                A slot is checked against the identifier of its cell, a stale one is passed
+ */
+static bool Parameters_Registry_Probe(PARAMETERS_REGISTRY_T *registry, char *name, unsigned int hash,
+                                      PARAMETERS_CB_T **moudule, PARAMETERS_HANDLE_T *handle)
+{
+    PARAMETERS_REGISTRY_SLOT_T *slot;
+    unsigned int mask = registry->slot_size - 1;
+    unsigned int probe;
+    char found[17];
+
+    for (probe = 0; probe < registry->slot_size; probe++)
+    {
+        slot = &registry->slots[(hash + probe) & mask];
+        if (slot->table == 0)
+        {
+            break;
+        }
+        if (slot->hash == hash)
+        {
+            *moudule = registry->tables[slot->table - 1].moudule;
+            handle->index = slot->index;
+            handle->layout = (*moudule)->layout_version;
+            if (Parameters_Handle_Name(*moudule, *handle, found) && strncmp(found, name, 16) == 0)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @description:                                Find a parameter in any open table of the registry
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @param       {char} *name                    String identifier
+ * @param       {PARAMETERS_CB_T} **moudule     table holding the parameter
+ * @param       {PARAMETERS_HANDLE_T} *handle   Handle of the cell
+ * @return      {*}                             false if no table holds the identifier
+ * @note       :                                One probe of the global index, whatever the number of tables. The index
+ *                                              is only brought up to date with the tables when the probe misses.
+ *                                              The registry takes no lock, use it from one task.
+ */
+bool Parameters_Registry_Find(PARAMETERS_REGISTRY_T *registry, char *name, PARAMETERS_CB_T **moudule,
+                              PARAMETERS_HANDLE_T *handle)
+{
+    unsigned int hash, count;
+
+    if (registry->slots != NULL)
+    {
+        hash = Parameters_Hash_Name(name);
+        if (registry->index_valid && !registry->index_full && Parameters_Registry_Probe(registry, name, hash, moudule, handle))
+        {
+            return true;
+        }
+        if (Parameters_Registry_Index(registry))
+        {
+            return Parameters_Registry_Probe(registry, name, hash, moudule, handle);
+        }
+    }
+
+    for (count = 0; count < registry->info.number; count++)
+    {
+        *moudule = registry->tables[count].moudule;
+        if (*moudule != NULL && Parameters_Get_Handle(*moudule, name, handle))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @description:                                Largest region a table can still be given
+ * @param       {PARAMETERS_REGISTRY_T} *registry
+ * @return      {*}                             bytes of ROM
+ * @note       :
+ */
+unsigned int Parameters_Registry_Free(PARAMETERS_REGISTRY_T *registry)
+{
+    PARAMETERS_REGISTRY_RECORD_T *record;
+    unsigned int start, end, largest = 0;
+    unsigned char count = PARAMETERS_REGISTRY_NONE, other;
+
+    do
+    {
+        start = Parameters_Registry_Start(registry, count);
+        end = registry->ROM_size;
+        for (other = 0; other < registry->info.number; other++)
+        {
+            record = &registry->records[other];
+            if (record->offset + record->ROM_size > start && record->offset < end)
+            {
+                end = record->offset > start ? record->offset : start;
+            }
+        }
+        if (end > start && end - start > largest)
+        {
+            largest = end - start;
+        }
+        count++;
+    } while (count < registry->info.number);
+
+    return largest;
+}
@@ -0,0 +1,98 @@
+/*
+ * @Description    : Tables sharing one ROM region
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 19:10:26
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 19:10:26
+ * @FilePath       : \Parameters\src\Parameters_registry.h
+ */
+
+#ifndef _PARAMETERS_REGISTRY_H
+#define _PARAMETERS_REGISTRY_H
+
+#include "Parameters.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+#pragma pack(1)
+    // region of one table, as kept in the directory
+    typedef struct
+    {
+        char table_tag[16];
+        unsigned int offset;   // from the start of the registry region
+        unsigned int ROM_size; // bytes of ROM, Parameters_ROM_Size of the table
+        unsigned int size;     // size the table was initialized with
+    } PARAMETERS_REGISTRY_RECORD_T;
+
+    // head of a copy of the directory
+    typedef struct
+    {
+        char registry_tag[16];
+        unsigned int sequence; // the valid copy with the higher sequence is current
+        unsigned char number;  // records following the head
+        PARAMETERS_CHECK_T check_value;
+    } PARAMETERS_REGISTRY_INFO_T;
+#pragma pack()
+
+    // entry of the global index, open addressing on the hash of the identifier
+    typedef struct
+    {
+        unsigned int hash;
+        unsigned short index; // cell in the table
+        unsigned char table;  // record of the table plus one, 0 for a free slot
+    } PARAMETERS_REGISTRY_SLOT_T;
+
+    // an opened table, the global index is brought up to date when one of them changed its cells
+    typedef struct
+    {
+        PARAMETERS_CB_T *moudule; // NULL while the table is not open
+        unsigned short layout;    // layout_version the index was built for
+        unsigned short used_number;
+        unsigned short free_number;
+    } PARAMETERS_REGISTRY_TABLE_T;
+
+    typedef struct
+    {
+        unsigned int ROM_start_offset;
+        unsigned int ROM_size;
+        unsigned int sector;         // regions start on multiples of it, the erase size of the device
+        unsigned int directory_size; // bytes of one copy of the directory, two copies start the region
+
+        PARAMETERS_REGISTRY_INFO_T info;
+        PARAMETERS_REGISTRY_RECORD_T *records; // capacity records, the directory in RAM
+        PARAMETERS_REGISTRY_TABLE_T *tables;   // capacity tables, parallel to the records
+        unsigned char capacity;
+
+        PARAMETERS_REGISTRY_SLOT_T *slots; // global index, NULL to search every table
+        unsigned int slot_size;            // power of two, larger than twice the parameters of all tables
+        bool index_valid;                  // built for the cells of the open tables
+        bool index_full;                   // the slots could not hold every parameter, every table is searched
+
+        bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int);
+        bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int);
+        PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int);
+    } PARAMETERS_REGISTRY_T;
+
+    bool Parameters_Registry_Init(PARAMETERS_REGISTRY_T *registry, char *registry_tag, unsigned int ROM_block,
+                                  unsigned int size, unsigned int sector, PARAMETERS_REGISTRY_RECORD_T *records,
+                                  PARAMETERS_REGISTRY_TABLE_T *tables, unsigned char capacity,
+                                  PARAMETERS_REGISTRY_SLOT_T *slots, unsigned int slot_size,
+                                  bool (*Read_From_ROM)(unsigned char *, unsigned int, unsigned int),
+                                  bool (*Write_2_ROM)(unsigned char *, unsigned int, unsigned int),
+                                  PARAMETERS_CHECK_T (*checkout)(unsigned char *, unsigned int));
+    bool Parameters_Registry_Open(PARAMETERS_REGISTRY_T *registry, PARAMETERS_CB_T *moudule, char *table_tag,
+                                  unsigned char *RAM_block, unsigned int size, const PARAMETERS_CONFIG_T *config);
+    bool Parameters_Registry_Resize(PARAMETERS_REGISTRY_T *registry, PARAMETERS_CB_T *moudule,
+                                    unsigned char *RAM_block, unsigned int size, const PARAMETERS_CONFIG_T *config);
+    bool Parameters_Registry_Remove(PARAMETERS_REGISTRY_T *registry, char *table_tag);
+    bool Parameters_Registry_Find(PARAMETERS_REGISTRY_T *registry, char *name, PARAMETERS_CB_T **moudule,
+                                  PARAMETERS_HANDLE_T *handle);
+    unsigned int Parameters_Registry_Free(PARAMETERS_REGISTRY_T *registry);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif //_PARAMETERS_REGISTRY_H
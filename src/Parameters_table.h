@@ -0,0 +1,93 @@
+/*
+ * @Description    : Parameter tables declared at build time
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 17:20:05
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 17:20:05
+ * @FilePath       : \Parameters\src\Parameters_table.h
+ */
+
+#ifndef _PARAMETERS_TABLE_H
+#define _PARAMETERS_TABLE_H
+
+#include "Parameters.h"
+
+/*
+ * A table is a list macro calling X(P, NAME, TYPE, DEFAULT) for each parameter, TYPE without the PARAMETERS_TYPE_
+ * prefix. P is passed through and names the generated symbols:
+ *
+ *      #define NAV_PARAMETERS(X, P)        \
+ *          X(P, NAV_GAIN_P, F32, 1.5f)     \
+ *          X(P, NAV_RATE_HZ, UINT16, 50)
+ *
+ *      PARAMETERS_TABLE_DECLARE(NAV, NAV_PARAMETERS)   in a header
+ *      PARAMETERS_TABLE_DEFINE(NAV, NAV_PARAMETERS)    in one source file
+ *
+ * which gives the indexes NAV_NAV_GAIN_P, NAV_NAV_RATE_HZ and NAV_COUNT, the entries NAV_entries with the default
+ * values and identifier hashes, the handles NAV_handles, NAV_Register(moudule) to create or find all of them at
+ * startup, and NAV_Get_NAV_GAIN_P(moudule, &value) / NAV_Set_NAV_GAIN_P(moudule, value) reading and writing through
+ * a handle without any string. The identifier is the NAME itself and is limited to 16 characters.
+ */
+
+// C type of each PARAMETERS_TYPE_T
+#define PARAMETERS_CTYPE_UINT8 unsigned char
+#define PARAMETERS_CTYPE_INT8 signed char
+#define PARAMETERS_CTYPE_UINT16 unsigned short
+#define PARAMETERS_CTYPE_INT16 short
+#define PARAMETERS_CTYPE_UINT32 unsigned int
+#define PARAMETERS_CTYPE_INT32 int
+#define PARAMETERS_CTYPE_UINT64 unsigned long long
+#define PARAMETERS_CTYPE_INT64 long long
+#define PARAMETERS_CTYPE_F32 float
+#define PARAMETERS_CTYPE_F64 double
+
+// FNV-1a of a string literal as Parameters_Hash_Name computes it, folded by the compiler
+#define PARAMETERS_NAME_BYTE(name, i) ((i) < sizeof(name) - 1 ? (unsigned char)(name)[(i) < sizeof(name) - 1 ? (i) : 0] : 0u)
+#define PARAMETERS_NAME_STEP(hash, name, i) \
+    ((unsigned int)(((hash) ^ PARAMETERS_NAME_BYTE(name, i)) * ((i) < sizeof(name) - 1 ? 16777619u : 1u)))
+#define PARAMETERS_NAME_HASH(name)                                                                                         \
+    PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(                                \
+    PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(                                 \
+    PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(                                 \
+    PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(PARAMETERS_NAME_STEP(                                 \
+        2166136261u, name, 0), name, 1), name, 2), name, 3), name, 4), name, 5), name, 6), name, 7),                     \
+        name, 8), name, 9), name, 10), name, 11), name, 12), name, 13), name, 14), name, 15)
+
+#define PARAMETERS_TABLE_INDEX(prefix, name, type, initial) prefix##_##name,
+
+#define PARAMETERS_TABLE_ENTRY(prefix, name, type, initial) \
+    {#name, PARAMETERS_TYPE_##type, {.type = (initial)}, PARAMETERS_NAME_HASH(#name)},
+
+// an identifier longer than 16 characters makes a negative array size
+#define PARAMETERS_TABLE_CHECK(prefix, name, type, initial) \
+    typedef char prefix##_##name##_too_long[sizeof(#name) <= 17 ? 1 : -1];
+
+#define PARAMETERS_TABLE_ACCESS(prefix, name, type, initial)                                                          \
+    static inline bool prefix##_Get_##name(PARAMETERS_CB_T *moudule, PARAMETERS_CTYPE_##type *value)                \
+    {                                                                                                               \
+        return Parameters_Get_by_handle(moudule, prefix##_handles[prefix##_##name], PARAMETERS_TYPE_##type, value);  \
+    }                                                                                                               \
+    static inline bool prefix##_Set_##name(PARAMETERS_CB_T *moudule, PARAMETERS_CTYPE_##type value)                 \
+    {                                                                                                               \
+        return Parameters_Set_by_handle(moudule, prefix##_handles[prefix##_##name], PARAMETERS_TYPE_##type, &value); \
+    }
+
+#define PARAMETERS_TABLE_DECLARE(prefix, list)                                                   \
+    enum                                                                                         \
+    {                                                                                            \
+        list(PARAMETERS_TABLE_INDEX, prefix) prefix##_COUNT                                      \
+    };                                                                                           \
+    extern const PARAMETERS_ENTRY_T prefix##_entries[prefix##_COUNT];                            \
+    extern PARAMETERS_HANDLE_T prefix##_handles[prefix##_COUNT];                                 \
+    list(PARAMETERS_TABLE_ACCESS, prefix)                                                        \
+    static inline bool prefix##_Register(PARAMETERS_CB_T *moudule)                               \
+    {                                                                                            \
+        return Parameters_Register(moudule, prefix##_entries, prefix##_COUNT, prefix##_handles); \
+    }
+
+#define PARAMETERS_TABLE_DEFINE(prefix, list)                                                    \
+    list(PARAMETERS_TABLE_CHECK, prefix)                                                         \
+    const PARAMETERS_ENTRY_T prefix##_entries[prefix##_COUNT] = {list(PARAMETERS_TABLE_ENTRY, prefix)}; \
+    PARAMETERS_HANDLE_T prefix##_handles[prefix##_COUNT];
+
+#endif //_PARAMETERS_TABLE_H
@@ -0,0 +1,414 @@
+/*
+ * @Description    : ROM of Parameters kept in a file, through pread / pwrite or mmap
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 23:02:14
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 23:02:14
+ * @FilePath       : \Parameters\src\port\Parameters_file.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Parameters_file.h"
+
+// the file the callbacks of Parameters_Init go to, they take no context
+static PARAMETERS_FILE_T *Parameters_File_Current;
+
+/**
+ * @description:                                Move bytes between memory and the file with pread / pwrite
+ * @param       {int} fd                        file
+ * @param       {unsigned char} *data           bytes in memory
+ * @param       {unsigned int} offset           offset in the file
+ * @param       {unsigned int} size             number of bytes
+ * @param       {bool} write                    pwrite or pread
+ * @return      {*}                             every byte moved or not
+ * @note       :                                Short transfers go on, interrupted calls are made again
+ */
+static bool Parameters_File_Transfer(int fd, unsigned char *data, unsigned int offset, unsigned int size, bool write)
+{
+    ssize_t done;
+
+    while (size)
+    {
+        done = write ? pwrite(fd, data, size, offset) : pread(fd, data, size, offset);
+        if (done <= 0)
+        {
+            if (done < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += done;
+        offset += done;
+        size -= done;
+    }
+    return true;
+}
+
+/**
+ * @description:                                Make the writes made so far durable with one fdatasync / msync
+ * @param       {PARAMETERS_FILE_T} *file       opened file
+ * @return      {*}                             success or fail
+ * @note       :                                Waits for a sync already running, writes made during it need another one
+ */
+static bool Parameters_File_Commit(PARAMETERS_FILE_T *file)
+{
+    unsigned int page = (unsigned int)sysconf(_SC_PAGESIZE);
+    unsigned long target;
+    unsigned int start, end;
+    bool status;
+
+    pthread_mutex_lock(&file->mutex);
+    while (file->syncing)
+    {
+        pthread_cond_wait(&file->synced, &file->mutex);
+    }
+    if (file->durable == file->sequence)
+    {
+        pthread_mutex_unlock(&file->mutex);
+        return true;
+    }
+    file->syncing = true;
+    target = file->sequence;
+    start = file->dirty_start / page * page;
+    end = file->dirty_end;
+    file->dirty_start = file->size;
+    file->dirty_end = 0;
+    pthread_mutex_unlock(&file->mutex);
+
+    if (file->mode == PARAMETERS_FILE_MMAP)
+    {
+        status = start >= end || msync(file->map + start, end - start, MS_SYNC) == 0;
+    }
+    else
+    {
+        status = fdatasync(file->fd) == 0;
+    }
+
+    pthread_mutex_lock(&file->mutex);
+    file->syncing = false;
+    if (status)
+    {
+        file->durable = target;
+        file->syncs++;
+    }
+    else
+    {
+        // the range is synced again with the next group
+        file->failures++;
+        file->dirty_start = start < file->dirty_start ? start : file->dirty_start;
+        file->dirty_end = end > file->dirty_end ? end : file->dirty_end;
+    }
+    pthread_cond_broadcast(&file->synced);
+    pthread_mutex_unlock(&file->mutex);
+
+    if (!status)
+    {
+        printf("Parameters 0X%x file sync failed!\n", (uintptr_t)file);
+    }
+    return status;
+}
+
+/**
+ * @description:                                Sync once per window while writes are waiting
+ * @param       {void} *arg                     PARAMETERS_FILE_T
+ * @return      {*}
+ * @note       :                                The window starts with the first write not yet synced
+ */
+static void *Parameters_File_Task(void *arg)
+{
+    PARAMETERS_FILE_T *file = (PARAMETERS_FILE_T *)arg;
+    struct timespec until;
+
+    pthread_mutex_lock(&file->mutex);
+    while (!file->stop)
+    {
+        if (file->durable == file->sequence)
+        {
+            pthread_cond_wait(&file->written, &file->mutex);
+            continue;
+        }
+
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_nsec += (long)(file->window_us % 1000000) * 1000;
+        until.tv_sec += file->window_us / 1000000 + until.tv_nsec / 1000000000;
+        until.tv_nsec %= 1000000000;
+        while (!file->stop && pthread_cond_timedwait(&file->written, &file->mutex, &until) != ETIMEDOUT)
+        {
+        }
+        pthread_mutex_unlock(&file->mutex);
+
+        Parameters_File_Commit(file);
+
+        pthread_mutex_lock(&file->mutex);
+    }
+    pthread_mutex_unlock(&file->mutex);
+    return NULL;
+}
+
+/**
+ * @description:                                Open the file standing in for ROM
+ * @param       {PARAMETERS_FILE_T} *file       kept by the caller until Parameters_File_Close
+ * @param       {char} *path                    path of the file, created when missing
+ * @param       {unsigned int} size             bytes of ROM, a shorter file is extended with PARAMETERS_FILE_ERASED
+ * @param       {PARAMETERS_FILE_MODE_T} mode   pread / pwrite or mmap
+ * @param       {unsigned int} window_us        writes within it share one sync, 0 to sync in every write
+ * @return      {*}                             success or fail
+ * @note       :                                Parameters_File_Read, Parameters_File_Write and Parameters_File_Erase
+ *                                              then go to this file, one file is open at a time
+ */
+bool Parameters_File_Open(PARAMETERS_FILE_T *file, const char *path, unsigned int size, PARAMETERS_FILE_MODE_T mode,
+                          unsigned int window_us)
+{
+    unsigned char erased[4096];
+    struct stat status;
+    unsigned int offset, count;
+
+    if (Parameters_File_Current != NULL)
+    {
+        printf("Parameters 0X%x file already open!\n", (uintptr_t)Parameters_File_Current);
+        return false;
+    }
+
+    memset(file, 0, sizeof(PARAMETERS_FILE_T));
+    file->mode = mode;
+    file->size = size;
+    file->window_us = window_us;
+    file->dirty_start = size;
+    file->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (file->fd < 0 || fstat(file->fd, &status) != 0)
+    {
+        printf("Parameters 0X%x file %s open failed!\n", (uintptr_t)file, path);
+        if (file->fd >= 0)
+        {
+            close(file->fd);
+        }
+        return false;
+    }
+
+    memset(erased, PARAMETERS_FILE_ERASED, sizeof(erased));
+    for (offset = status.st_size < size ? (unsigned int)status.st_size : size; offset < size; offset += count)
+    {
+        count = size - offset < sizeof(erased) ? size - offset : sizeof(erased);
+        if (!Parameters_File_Transfer(file->fd, erased, offset, count, true))
+        {
+            printf("Parameters 0X%x file %s open failed!\n", (uintptr_t)file, path);
+            close(file->fd);
+            return false;
+        }
+    }
+
+    if (mode == PARAMETERS_FILE_MMAP)
+    {
+        file->map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+        if (file->map == MAP_FAILED)
+        {
+            printf("Parameters 0X%x file %s map failed!\n", (uintptr_t)file, path);
+            close(file->fd);
+            return false;
+        }
+    }
+
+    pthread_mutex_init(&file->mutex, NULL);
+    pthread_cond_init(&file->written, NULL);
+    pthread_cond_init(&file->synced, NULL);
+    if (window_us != 0 && pthread_create(&file->thread, NULL, Parameters_File_Task, file) != 0)
+    {
+        printf("Parameters 0X%x file sync task start failed!\n", (uintptr_t)file);
+        pthread_cond_destroy(&file->synced);
+        pthread_cond_destroy(&file->written);
+        pthread_mutex_destroy(&file->mutex);
+        if (file->map != NULL)
+        {
+            munmap(file->map, size);
+        }
+        close(file->fd);
+        return false;
+    }
+
+    Parameters_File_Current = file;
+    return true;
+}
+
+/**
+ * @description:                                Sync the last writes and close the file
+ * @param       {PARAMETERS_FILE_T} *file       file opened by Parameters_File_Open
+ * @return      {*}
+ * @note       :                                Tables on it must not be written any more
+ */
+void Parameters_File_Close(PARAMETERS_FILE_T *file)
+{
+    if (file->window_us != 0)
+    {
+        pthread_mutex_lock(&file->mutex);
+        file->stop = true;
+        pthread_cond_signal(&file->written);
+        pthread_mutex_unlock(&file->mutex);
+        pthread_join(file->thread, NULL);
+    }
+    Parameters_File_Commit(file);
+
+    Parameters_File_Current = NULL;
+    if (file->map != NULL)
+    {
+        munmap(file->map, file->size);
+    }
+    close(file->fd);
+    pthread_cond_destroy(&file->synced);
+    pthread_cond_destroy(&file->written);
+    pthread_mutex_destroy(&file->mutex);
+}
+
+/**
+ * @description:                                Wait until the writes made so far are durable
+ * @param       {PARAMETERS_FILE_T} *file       file opened by Parameters_File_Open
+ * @return      {*}                             false if the sync failed
+ * @note       :                                Syncs at once instead of waiting for the end of the window
+ */
+bool Parameters_File_Sync(PARAMETERS_FILE_T *file)
+{
+    return Parameters_File_Commit(file);
+}
+
+/**
+ * @description:                                Read_From_ROM callback of the open file
+ * @param       {unsigned char} *dst            bytes in RAM
+ * @param       {unsigned int} offset           offset in the file
+ * @param       {unsigned int} size             number of bytes
+ * @return      {*}                             success or fail
+ * @note       :
+ */
+bool Parameters_File_Read(unsigned char *dst, unsigned int offset, unsigned int size)
+{
+    PARAMETERS_FILE_T *file = Parameters_File_Current;
+
+    if (file == NULL || (unsigned long)offset + size > file->size)
+    {
+        return false;
+    }
+    if (file->mode == PARAMETERS_FILE_MMAP)
+    {
+        memcpy(dst, file->map + offset, size);
+        return true;
+    }
+    return Parameters_File_Transfer(file->fd, dst, offset, size, false);
+}
+
+/**
+ * @description:                                Write_2_ROM callback of the open file
+ * @param       {unsigned char} *src            bytes in RAM
+ * @param       {unsigned int} offset           offset in the file
+ * @param       {unsigned int} size             number of bytes
+ * @return      {*}                             success or fail
+ * @note       :                                The bytes are in the page cache on return, durable after the sync of
+ *                                              their window, or before return when window_us is 0
+ */
+bool Parameters_File_Write(unsigned char *src, unsigned int offset, unsigned int size)
+{
+    PARAMETERS_FILE_T *file = Parameters_File_Current;
+
+    if (file == NULL || (unsigned long)offset + size > file->size)
+    {
+        return false;
+    }
+    if (file->mode == PARAMETERS_FILE_MMAP)
+    {
+        memcpy(file->map + offset, src, size);
+    }
+    else if (!Parameters_File_Transfer(file->fd, src, offset, size, true))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&file->mutex);
+    file->sequence++;
+    file->dirty_start = offset < file->dirty_start ? offset : file->dirty_start;
+    file->dirty_end = offset + size > file->dirty_end ? offset + size : file->dirty_end;
+    if (file->window_us != 0 && file->sequence - 1 == file->durable)
+    {
+        // the first write of a window
+        pthread_cond_signal(&file->written);
+    }
+    pthread_mutex_unlock(&file->mutex);
+
+    return file->window_us != 0 || Parameters_File_Commit(file);
+}
+
+/**
+ * @description:                                Erase_ROM callback of the open file
+ * @param       {unsigned int} offset           offset in the file
+ * @param       {unsigned int} size             number of bytes
+ * @return      {*}                             success or fail
+ * @note       :                                Fills the bytes with PARAMETERS_FILE_ERASED
+ */
+bool Parameters_File_Erase(unsigned int offset, unsigned int size)
+{
+    unsigned char erased[256];
+    unsigned int count;
+
+    memset(erased, PARAMETERS_FILE_ERASED, sizeof(erased));
+    while (size)
+    {
+        count = size < sizeof(erased) ? size : sizeof(erased);
+        if (!Parameters_File_Write(erased, offset, count))
+        {
+            return false;
+        }
+        offset += count;
+        size -= count;
+    }
+    return true;
+}
+
+/**
+ * @description:                                Map the cells of a table as its RAM block
+ * @param       {PARAMETERS_FILE_T} *file       file opened by Parameters_File_Open
+ * @param       {unsigned int} ROM_block        offset of the table in the file, as given to Parameters_Init_Ex
+ * @param       {unsigned int} size             size of the table, as given to Parameters_Init_Ex
+ * @return      {*}                             RAM block for a table initialized with the mapped option, NULL on failure
+ * @note       :                                A private mapping: pages are shared with the file until the table
+ *                                              writes a cell in RAM, the file only changes through Write_2_ROM
+ */
+unsigned char *Parameters_File_Map(PARAMETERS_FILE_T *file, unsigned int ROM_block, unsigned int size)
+{
+    unsigned int offset = ROM_block + sizeof(PARAMETERS_TABLE_INFO_T);
+    unsigned int start = offset / (unsigned int)sysconf(_SC_PAGESIZE) * (unsigned int)sysconf(_SC_PAGESIZE);
+    unsigned char *map;
+
+    if ((unsigned long)offset + size > file->size)
+    {
+        printf("Parameters 0X%x file map out of range!\n", (uintptr_t)file);
+        return NULL;
+    }
+    map = mmap(NULL, offset - start + size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file->fd, start);
+    if (map == MAP_FAILED)
+    {
+        printf("Parameters 0X%x file map failed!\n", (uintptr_t)file);
+        return NULL;
+    }
+    return map + (offset - start);
+}
+
+/**
+ * @description:                                Release a RAM block given by Parameters_File_Map
+ * @param       {unsigned char} *RAM_block      RAM block of the table
+ * @param       {unsigned int} size             size of the table
+ * @return      {*}
+ * @note       :
+ */
+void Parameters_File_Unmap(unsigned char *RAM_block, unsigned int size)
+{
+    unsigned int page = (unsigned int)sysconf(_SC_PAGESIZE);
+    unsigned int shift = (unsigned int)((uintptr_t)RAM_block % page);
+
+    munmap(RAM_block - shift, shift + size);
+}
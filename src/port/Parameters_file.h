@@ -0,0 +1,76 @@
+/*
+ * @Description    : ROM of Parameters kept in a file, through pread / pwrite or mmap
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 23:02:14
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 23:02:14
+ * @FilePath       : \Parameters\src\port\Parameters_file.h
+ */
+
+#ifndef _PARAMETERS_FILE_H
+#define _PARAMETERS_FILE_H
+
+#include <pthread.h>
+
+#include "Parameters.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+// value of bytes the file is extended with, as erased flash
+#define PARAMETERS_FILE_ERASED 0xFF
+
+    typedef enum
+    {
+        PARAMETERS_FILE_PWRITE = 0, // pread / pwrite calls, fdatasync
+        PARAMETERS_FILE_MMAP,       // copies to and from a shared mapping of the file, msync
+    } PARAMETERS_FILE_MODE_T;
+
+    /**
+     * @description:                    A file standing in for the ROM of every table of the process
+     * @note       :                    Writes reach the page cache before Parameters_File_Write returns, so they outlive
+     *                                  the process. Writes within window_us of the first one not yet synced share one
+     *                                  fdatasync / msync made by a thread, a power loss can lose that window.
+     *                                  Parameters_File_Sync waits for the writes made so far.
+     */
+    typedef struct
+    {
+        int fd;
+        PARAMETERS_FILE_MODE_T mode;
+        unsigned char *map; // shared mapping of the whole file in the mmap mode
+        unsigned int size;
+        unsigned int window_us; // 0 syncs in every write
+
+        pthread_t thread;
+        pthread_mutex_t mutex;
+        pthread_cond_t written; // a write is waiting for a sync or the thread is asked to stop
+        pthread_cond_t synced;  // a sync ended
+        bool syncing;           // one sync at a time, a later one covers the writes made during it
+        bool stop;
+
+        unsigned long sequence;   // writes so far
+        unsigned long durable;    // writes covered by a sync
+        unsigned int dirty_start; // bytes written since the last msync
+        unsigned int dirty_end;
+        unsigned long syncs;
+        unsigned long failures; // syncs the system refused, their writes stay not durable
+    } PARAMETERS_FILE_T;
+
+    bool Parameters_File_Open(PARAMETERS_FILE_T *file, const char *path, unsigned int size, PARAMETERS_FILE_MODE_T mode,
+                              unsigned int window_us);
+    void Parameters_File_Close(PARAMETERS_FILE_T *file);
+    bool Parameters_File_Sync(PARAMETERS_FILE_T *file);
+
+    bool Parameters_File_Read(unsigned char *dst, unsigned int offset, unsigned int size);
+    bool Parameters_File_Write(unsigned char *src, unsigned int offset, unsigned int size);
+    bool Parameters_File_Erase(unsigned int offset, unsigned int size);
+
+    unsigned char *Parameters_File_Map(PARAMETERS_FILE_T *file, unsigned int ROM_block, unsigned int size);
+    void Parameters_File_Unmap(unsigned char *RAM_block, unsigned int size);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif //_PARAMETERS_FILE_H
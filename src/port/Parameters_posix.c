@@ -0,0 +1,263 @@
+/*
+ * @Description    : Write-behind task and change waiters of Parameters on POSIX threads
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 14:20:06
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 14:20:06
+ * @FilePath       : \Parameters\src\port\Parameters_posix.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Parameters_posix.h"
+
+/**
+ * @description:                                Wake the task, a record was queued
+ * @param       {void} *context                 PARAMETERS_WORKER_T of the table
+ * @return      {*}
+ * @note       :                                Called by writers under OS_LOCK
+ */
+static void Parameters_Worker_Notify(void *context)
+{
+    PARAMETERS_WORKER_T *worker = (PARAMETERS_WORKER_T *)context;
+
+    pthread_mutex_lock(&worker->mutex);
+    pthread_cond_signal(&worker->queued);
+    pthread_mutex_unlock(&worker->mutex);
+}
+
+/**
+ * @description:                                Block until the task made a number of records durable
+ * @param       {void} *context                 PARAMETERS_WORKER_T of the table
+ * @param       {unsigned int} target           value of async_durable to wait for
+ * @return      {*}                             false if the task ended before
+ * @note       :
+ */
+static bool Parameters_Worker_Wait(void *context, unsigned int target)
+{
+    PARAMETERS_WORKER_T *worker = (PARAMETERS_WORKER_T *)context;
+    bool status;
+
+    pthread_mutex_lock(&worker->mutex);
+    while ((int)(worker->moudule->async_durable - target) < 0 && worker->running)
+    {
+        pthread_cond_wait(&worker->durable, &worker->mutex);
+    }
+    status = (int)(worker->moudule->async_durable - target) >= 0;
+    pthread_mutex_unlock(&worker->mutex);
+    return status;
+}
+
+/**
+ * @description:                                Drain the ring whenever records are queued
+ * @param       {void} *arg                     PARAMETERS_WORKER_T of the table
+ * @return      {*}
+ * @note       :                                A failed drain is retried after a delay that doubles up to max_backoff_us.
+ *                                              Queued records are drained once more when asked to stop.
+ */
+static void *Parameters_Worker_Task(void *arg)
+{
+    PARAMETERS_WORKER_T *worker = (PARAMETERS_WORKER_T *)arg;
+    PARAMETERS_CB_T *moudule = worker->moudule;
+    struct timespec until;
+    bool status;
+
+    pthread_mutex_lock(&worker->mutex);
+    while (true)
+    {
+        if (!worker->stop && moudule->async_head == moudule->async_tail && moudule->async_durable == moudule->async_tail)
+        {
+            pthread_cond_wait(&worker->queued, &worker->mutex);
+            continue;
+        }
+        pthread_mutex_unlock(&worker->mutex);
+
+        status = Parameters_Async_Drain(moudule);
+
+        pthread_mutex_lock(&worker->mutex);
+        pthread_cond_broadcast(&worker->durable);
+        if (worker->stop)
+        {
+            break;
+        }
+
+        if (status)
+        {
+            worker->backoff_us = 0;
+            continue;
+        }
+
+        worker->failures++;
+        worker->backoff_us = worker->backoff_us == 0 ? PARAMETERS_WORKER_BACKOFF_US : worker->backoff_us * 2;
+        if (worker->backoff_us > worker->max_backoff_us)
+        {
+            worker->backoff_us = worker->max_backoff_us;
+        }
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_nsec += (long)(worker->backoff_us % 1000000) * 1000;
+        until.tv_sec += worker->backoff_us / 1000000 + until.tv_nsec / 1000000000;
+        until.tv_nsec %= 1000000000;
+        while (!worker->stop && pthread_cond_timedwait(&worker->queued, &worker->mutex, &until) == 0)
+        {
+        }
+    }
+    worker->running = false;
+    pthread_cond_broadcast(&worker->durable);
+    pthread_mutex_unlock(&worker->mutex);
+    return NULL;
+}
+
+/**
+ * @description:                                Start a thread writing the changes of a table to ROM
+ * @param       {PARAMETERS_WORKER_T} *worker   task to start, kept by the caller until Parameters_Worker_Stop
+ * @param       {PARAMETERS_CB_T} *moudule      Pointer to the parameter management modules, initialized with async_ring
+ * @param       {unsigned int} max_backoff_us   longest delay between retries of a failing ROM
+ * @return      {*}                             success or fail
+ * @note       :                                Parameters_Flush then waits for the thread instead of draining the ring
+ */
+bool Parameters_Worker_Start(PARAMETERS_WORKER_T *worker, PARAMETERS_CB_T *moudule, unsigned int max_backoff_us)
+{
+    if (moudule->config.async_ring == NULL)
+    {
+        printf("Parameters 0X%x no async ring!\n", (uintptr_t)moudule);
+        return false;
+    }
+
+    worker->moudule = moudule;
+    worker->stop = false;
+    worker->running = true;
+    worker->max_backoff_us = max_backoff_us < PARAMETERS_WORKER_BACKOFF_US ? PARAMETERS_WORKER_BACKOFF_US : max_backoff_us;
+    worker->backoff_us = 0;
+    worker->failures = 0;
+    pthread_mutex_init(&worker->mutex, NULL);
+    pthread_cond_init(&worker->queued, NULL);
+    pthread_cond_init(&worker->durable, NULL);
+
+    if (pthread_create(&worker->thread, NULL, Parameters_Worker_Task, worker) != 0)
+    {
+        printf("Parameters 0X%x worker start failed!\n", (uintptr_t)moudule);
+        pthread_cond_destroy(&worker->durable);
+        pthread_cond_destroy(&worker->queued);
+        pthread_mutex_destroy(&worker->mutex);
+        return false;
+    }
+
+    OS_LOCK();
+    moudule->async_worker = worker;
+    moudule->Async_Notify = Parameters_Worker_Notify;
+    moudule->Async_Wait = Parameters_Worker_Wait;
+    OS_UNLOCK();
+
+    // records queued before the thread was attached
+    Parameters_Worker_Notify(worker);
+    return true;
+}
+
+/**
+ * @description:                                Stop the thread after one more drain of the ring
+ * @param       {PARAMETERS_WORKER_T} *worker   task started by Parameters_Worker_Start
+ * @return      {*}
+ * @note       :                                Parameters_Flush calls already waiting return, with false if ROM is behind.
+ *                                              Must not race new Parameters_Flush calls. Later changes stay queued
+ *                                              until Parameters_Flush drains them.
+ */
+void Parameters_Worker_Stop(PARAMETERS_WORKER_T *worker)
+{
+    OS_LOCK();
+    worker->moudule->Async_Notify = NULL;
+    worker->moudule->Async_Wait = NULL;
+    worker->moudule->async_worker = NULL;
+    OS_UNLOCK();
+
+    pthread_mutex_lock(&worker->mutex);
+    worker->stop = true;
+    pthread_cond_broadcast(&worker->queued);
+    pthread_mutex_unlock(&worker->mutex);
+
+    pthread_join(worker->thread, NULL);
+    pthread_cond_destroy(&worker->durable);
+    pthread_cond_destroy(&worker->queued);
+    pthread_mutex_destroy(&worker->mutex);
+}
+
+/**
+ * @description:                                Prepare a waiter before subscribing it
+ * @param       {PARAMETERS_WAITER_T} *waiter   waiter to prepare
+ * @return      {*}
+ * @note       :
+ */
+void Parameters_Waiter_Init(PARAMETERS_WAITER_T *waiter)
+{
+    pthread_mutex_init(&waiter->mutex, NULL);
+    pthread_cond_init(&waiter->changed, NULL);
+    waiter->generation = 0;
+}
+
+/**
+ * @description:                                Release a waiter after unsubscribing it
+ * @param       {PARAMETERS_WAITER_T} *waiter   waiter to release
+ * @return      {*}
+ * @note       :
+ */
+void Parameters_Waiter_Destroy(PARAMETERS_WAITER_T *waiter)
+{
+    pthread_cond_destroy(&waiter->changed);
+    pthread_mutex_destroy(&waiter->mutex);
+}
+
+/**
+ * @description:                                Subscription callback waking the threads waiting on a waiter
+ * @param       {void} *context                 PARAMETERS_WAITER_T given to Parameters_Subscribe
+ * @param       {const char} *name              identifier of the changed parameter
+ * @param       {unsigned int} generation       generation of the change
+ * @return      {*}
+ * @note       :
+ */
+void Parameters_Waiter_Notify(void *context, const char *name, unsigned int generation)
+{
+    PARAMETERS_WAITER_T *waiter = (PARAMETERS_WAITER_T *)context;
+
+    (void)name;
+    pthread_mutex_lock(&waiter->mutex);
+    waiter->generation = generation;
+    pthread_cond_broadcast(&waiter->changed);
+    pthread_mutex_unlock(&waiter->mutex);
+}
+
+/**
+ * @description:                                Wait for a change newer than the one seen last
+ * @param       {PARAMETERS_WAITER_T} *waiter   subscribed waiter
+ * @param       {unsigned int} *seen            generation seen last, updated to the newest one
+ * @param       {unsigned int} timeout_ms       longest wait, 0 to wait forever
+ * @return      {*}                             false on timeout
+ * @note       :
+ */
+bool Parameters_Waiter_Wait(PARAMETERS_WAITER_T *waiter, unsigned int *seen, unsigned int timeout_ms)
+{
+    struct timespec until;
+    bool status = true;
+
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    until.tv_sec += timeout_ms / 1000 + until.tv_nsec / 1000000000;
+    until.tv_nsec %= 1000000000;
+
+    pthread_mutex_lock(&waiter->mutex);
+    while (status && waiter->generation == *seen)
+    {
+        if (timeout_ms == 0)
+        {
+            pthread_cond_wait(&waiter->changed, &waiter->mutex);
+        }
+        else
+        {
+            status = pthread_cond_timedwait(&waiter->changed, &waiter->mutex, &until) == 0;
+        }
+    }
+    status = waiter->generation != *seen;
+    *seen = waiter->generation;
+    pthread_mutex_unlock(&waiter->mutex);
+    return status;
+}
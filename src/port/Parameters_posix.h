@@ -0,0 +1,62 @@
+/*
+ * @Description    : Write-behind task and change waiters of Parameters on POSIX threads
+ * @Author         : Aiyangsky
+ * @Date           : 2026-10-18 14:20:06
+ * @LastEditors    : Aiyangsky
+ * @LastEditTime   : 2026-10-18 14:20:06
+ * @FilePath       : \Parameters\src\port\Parameters_posix.h
+ */
+
+#ifndef _PARAMETERS_POSIX_H
+#define _PARAMETERS_POSIX_H
+
+#include <pthread.h>
+
+#include "Parameters.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+// first delay after a failed drain, doubled on every further failure
+#define PARAMETERS_WORKER_BACKOFF_US 1000
+
+    typedef struct
+    {
+        PARAMETERS_CB_T *moudule;
+        pthread_t thread;
+        pthread_mutex_t mutex;
+        pthread_cond_t queued;  // records were queued or the task is asked to stop
+        pthread_cond_t durable; // async_durable moved on
+        bool stop;
+        bool running; // cleared when the thread ends
+
+        unsigned int max_backoff_us; // longest delay between retries of a failing ROM
+        unsigned int backoff_us;     // current delay, 0 while ROM writes succeed
+        unsigned long failures;      // drains stopped by a write failure
+    } PARAMETERS_WORKER_T;
+
+    /**
+     * @description:                    Condition a thread can wait on for the changes of a subscription
+     * @note       :                    Pass Parameters_Waiter_Notify and the waiter to Parameters_Subscribe
+     */
+    typedef struct
+    {
+        pthread_mutex_t mutex;
+        pthread_cond_t changed;
+        unsigned int generation; // generation of the last change seen by Parameters_Waiter_Notify
+    } PARAMETERS_WAITER_T;
+
+    bool Parameters_Worker_Start(PARAMETERS_WORKER_T *worker, PARAMETERS_CB_T *moudule, unsigned int max_backoff_us);
+    void Parameters_Worker_Stop(PARAMETERS_WORKER_T *worker);
+
+    void Parameters_Waiter_Init(PARAMETERS_WAITER_T *waiter);
+    void Parameters_Waiter_Destroy(PARAMETERS_WAITER_T *waiter);
+    void Parameters_Waiter_Notify(void *context, const char *name, unsigned int generation);
+    bool Parameters_Waiter_Wait(PARAMETERS_WAITER_T *waiter, unsigned int *seen, unsigned int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif //_PARAMETERS_POSIX_H